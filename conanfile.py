@@ -17,3 +17,9 @@ class xSDK(ConanFile):
         tc = CMakeDeps(self)
         tc.generate()
 
+    def package_info(self):
+        self.cpp_info.libs = ["xbase"]
+        if self.settings.os == "Windows":
+            self.cpp_info.system_libs = ["iphlpapi"]
+        elif self.settings.os in ["Linux", "FreeBSD"]:
+            self.cpp_info.system_libs = ["pthread", "stdc++fs"]
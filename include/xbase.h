@@ -1,6 +1,13 @@
 #pragma once
 
 #include "xbase/xdata.h"
+#include "xbase/xdata_core.h"
+#include "xbase/xdata_entry.h"
+#include "xbase/xdata_gather.h"
+#include "xbase/xdata_intern.h"
+#include "xbase/xdata_pool.h"
+#include "xbase/xdata_record.h"
+#include "xbase/xdata_slot.h"
 #include "xbase/xobject.h"
 #include "xbase/xpointers.h"
 #include "xbase/xuid.h"
@@ -1,18 +1,27 @@
 #pragma once
 
 #include "xuid.h" // For TypeUid
+#include "xdata_entry.h"
 #include "xpointers.h"
 
+#include <algorithm>
 #include <any>
+#include <array>
 #include <cassert>
+#include <functional>
 #include <memory>
 #include <set>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <vector>
 
 namespace xsdk {
 
+namespace xdata {
+    class TypeFilter;
+} // namespace xdata
+
 /**
  * @brief Interface for data container.
  *
@@ -31,54 +40,361 @@ public:
     enum class CloneSetType { Include, Exclude };
     /**
      * @brief Clone an object with necessary types.
+     * @param _filter Precompiled filter of the types to clone, see xdata::TypeFilter.
+     * @return New cloned object or a null pointer if cloning failed.
+     */
+    virtual IData::UPtr Clone(const xdata::TypeFilter& _filter) const = 0;
+    /**
+     * @brief Clone an object with necessary types.
+     * Builds xdata::TypeFilter for each call, use Clone(const xdata::TypeFilter&) for repeated clones.
      * @param _cloned_types Set of types to include or exclude when cloning.
      * @param _set_type Type of set to use. Exclude or include types from _cloned_types set.
      * @return New cloned object or a null pointer if cloning failed.
      */
     virtual IData::UPtr Clone(const std::set<uint64_t>& _cloned_types = {},
-                              CloneSetType              _set_type     = CloneSetType::Exclude) const = 0;
+                              CloneSetType              _set_type     = CloneSetType::Exclude) const;
+    /**
+     * @brief Clone the necessary types into an existing container, replacing all its data.
+     *
+     * Unlike Clone() no new container is created, and if the destination is of the same implementation its storage
+     * is reused, so cloning into a recycled container (see xdata::Pool) does no allocations in steady state.
+     * The destination keeps its own memory budget settings.
+     * @param _dst Destination container, may be this container (then the not cloned types are removed).
+     * @param _filter Precompiled filter of the types to clone, see xdata::TypeFilter.
+     */
+    virtual void CloneInto(IData& _dst, const xdata::TypeFilter& _filter) const = 0;
+    /**
+     * @brief Clone the necessary types into an existing container, replacing all its data.
+     * @param _dst Destination container, may be this container (then the not cloned types are removed).
+     * @param _cloned_types Set of types to include or exclude when cloning.
+     * @param _set_type Type of set to use. Exclude or include types from _cloned_types set.
+     */
+    virtual void CloneInto(IData&                    _dst,
+                           const std::set<uint64_t>& _cloned_types = {},
+                           CloneSetType              _set_type     = CloneSetType::Exclude) const;
+    /**
+     * @brief Remove all data from the container.
+     * The container keeps its storage capacity (and memory budget settings) for reuse, the storage of the UIDs not set
+     * since the previous Clear() is released, so reusing a container for varying UIDs doesn't grow it without bound.
+     */
+    virtual void Clear() = 0;
+    /**
+     * @brief Make an immutable snapshot of the container.
+     *
+     * The snapshot is a single block holding the index of the UIDs (sorted) and the entries laid out next to each
+     * other (the reference counter is allocated separately), reads from it take no locks, so many reader threads share
+     * one compact read-only block. The values are shared with this container, not copied.
+     * Mutations of the snapshot fail: DataSetEntry() returns -1, DataRemoveEntry() returns an empty entry, DataReset()
+     * returns false, Clear(), DataBudgetSet() and DataBudgetPolicySet() do nothing. Use Clone() for get a mutable
+     * copy.
+     * @return The snapshot, a snapshot returns itself.
+     */
+    virtual IData::SPtrC Freeze() const = 0;
+
+    /**
+     * @brief Enum class for EvictPolicy.
+     *
+     * Defines how the entries of a UID are ranked for eviction when the container exceeds its memory budget: by the
+     * time they were set (OldestFirst), by the time they were set or last read (Lru), or never evicted (Never).
+     */
+    enum class EvictPolicy { OldestFirst, Lru, Never };
+    /**
+     * @brief Get estimated memory retained by the container entries, see xdata::SizerRegister().
+     * @return Sum of the estimated sizes of all faces and holders in bytes, lazy faces are not accounted.
+     */
+    virtual size_t DataMemoryUsage() const                                                                = 0;
+    /**
+     * @brief Set memory budget of the container.
+     *
+     * The budget is a ceiling for DataMemoryUsage() checked on every DataSetEntry(): if it's exceeded, the entries of
+     * the whole container (except the entry being set) are evicted in the order of their policies ranks, oldest first,
+     * until the usage fits the budget. If the entry can't fit even after evicting all evictable entries, it's
+     * rejected: DataSetEntry() returns -1 and the container is not changed. Eviction shifts indexes of the entries like
+     * DataRemoveEntry() does.
+     * @param _max_bytes Budget in bytes, 0 for unlimited.
+     * @param _policy Eviction policy of the UIDs without own policy, see DataBudgetPolicySet().
+     */
+    virtual void   DataBudgetSet(size_t _max_bytes, EvictPolicy _policy = EvictPolicy::OldestFirst)         = 0;
+    /**
+     * @brief Set eviction policy for the entries of a single UID, e.g. EvictPolicy::Never for pin them.
+     * @param _data_uid unique identifier for the data set entry
+     * @param _policy Eviction policy of the UID entries.
+     */
+    virtual void   DataBudgetPolicySet(uint64_t _data_uid, EvictPolicy _policy)                             = 0;
+
+    /**
+     * @brief Calculate a content hash of the container, e.g. for use as a cache key.
+     *
+     * The faces (not holders) of the selected entries are hashed by xdata::HashCompute(), the hashes are cached per
+     * entry and the result is cached per container, so repeated calls on an unchanged container are O(1) and a
+     * change rehashes only the changed entries. The result does not depend on the container implementation.
+     * Lazy entries are computed for hashing. Entries without hash (see xdata::HashCompute()) are skipped, e.g. opaque
+     * std::any values set through the legacy DataSet() (see xdata::Box::FromAny()).
+     * @param _filter Precompiled filter of the types to hash, see xdata::TypeFilter.
+     * @return The content hash.
+     */
+    virtual uint64_t Fingerprint(const xdata::TypeFilter& _filter) const = 0;
+    /**
+     * @brief Calculate a content hash of the container, see Fingerprint(const xdata::TypeFilter&).
+     * @param _types Set of types to include or exclude, like for Clone().
+     * @param _set_type Type of set to use. Exclude or include types from _types set.
+     * @return The content hash.
+     */
+    virtual uint64_t Fingerprint(const std::set<uint64_t>& _types    = {},
+                                 CloneSetType              _set_type = CloneSetType::Exclude) const;
     /**
      * @brief Add or update an entry in the data set of an IData object.
      * @param _data_uid unique identifier for the data set entry
-     * @param _face data to be added or updated
-     * @param _holder associated object or data to be added or updated
-     * @param _idx index of the entry in the data set
-     * @return size_t index of the updated entry in the data set
+     * @param _entry entry to be added or updated
+     * @param _idx index of the entry in the data set, use -1 (or any index past the end) for add new entry
+     * @return size_t index of the updated entry in the data set or -1 if the entry can't be set
      */
-    virtual size_t DataSet(uint64_t _data_uid, std::any&& _face, std::any&& _holder = std::any(), size_t _idx = 0) = 0;
+    virtual size_t              DataSetEntry(uint64_t _data_uid, xdata::Entry&& _entry, size_t _idx = 0) = 0;
     /**
      * @brief Get a items count by UID.
      * @param _data_uid unique identifier for the data set entry
      * @return Count of items.
      */
-    virtual size_t DataCount(uint64_t _data_uid) const                                                             = 0;
+    virtual size_t              DataCount(uint64_t _data_uid) const                                         = 0;
+    /**
+     * @brief Returns the entry of the specified index from the data container of the given UID.
+     * @param _data_uid unique identifier for the data set entry
+     * @param _idx The index of the entry to retrieve.
+     * @return Pointer to the entry stored in the container (valid until the container is modified) or nullptr if
+     * there is no such entry.
+     */
+    virtual const xdata::Entry* DataGetEntry(uint64_t _data_uid, size_t _idx = 0) const                     = 0;
+    /**
+     * @brief Remove an entry from the specified index from the data container of the given UID.
+     * @param _data_uid unique identifier for the data set entry
+     * @param _idx Index of the entry to be removed
+     * @return the removed entry or an empty entry if nothing has been removed
+     */
+    virtual xdata::Entry        DataRemoveEntry(uint64_t _data_uid, size_t _idx = 0)                        = 0;
+    /**
+     * @brief Remove all data from the data container by the given UID.
+     * @param _data_uid unique identifier for the data set entry
+     * @return True if something has been deleted, otherwise false
+     */
+    virtual bool                DataReset(uint64_t _data_uid)                                               = 0;
+
+    //-------------------------------------------------------------------------------
+    // Legacy std::any based methods, implemented over the entry methods above
+
+    /**
+     * @brief Add or update an entry in the data set of an IData object.
+     * @param _data_uid unique identifier for the data set entry
+     * @param _face data to be added or updated
+     * @param _holder associated object or data to be added or updated
+     * @param _idx index of the entry in the data set
+     * @return size_t index of the updated entry in the data set
+     */
+    virtual size_t DataSet(uint64_t _data_uid, std::any&& _face, std::any&& _holder = std::any(), size_t _idx = 0)
+    {
+        // The face of the expected type is boxed typed, so it's hashable and found without std::any_cast
+        auto face = xdata::Box::FromAny(std::move(_face), _data_uid);
+        return DataSetEntry(_data_uid, xdata::Entry(std::move(face), xdata::Box::FromAny(std::move(_holder))), _idx);
+    }
     /**
      * @brief Returns the value of the specified index from the data container of the given UID.
      * @param _data_uid unique identifier for the data set entry
      * @param _idx The index of the value to retrieve.
      * @return A std::pair containing the requested value and an empty std::any representing the error case.
      */
-    virtual std::pair<std::any, std::any> DataGet(uint64_t _data_uid, size_t _idx = 0) const                       = 0;
+    virtual std::pair<std::any, std::any> DataGet(uint64_t _data_uid, size_t _idx = 0) const
+    {
+        const auto* entry_p = DataGetEntry(_data_uid, _idx);
+        if (!entry_p)
+            return {};
+
+        return {entry_p->face.ToAny(), entry_p->holder.ToAny()};
+    }
     /**
      * @brief Remove an element from the specified index from the data container of the given UID.
      * @param _data_uid unique identifier for the data set entry
      * @param _idx Index of the element to be removed
      * @return the removed element as std::pair
      */
-    virtual std::pair<std::any, std::any> DataRemove(uint64_t _data_uid, size_t _idx = 0)                          = 0;
+    virtual std::pair<std::any, std::any> DataRemove(uint64_t _data_uid, size_t _idx = 0)
+    {
+        auto removed = DataRemoveEntry(_data_uid, _idx);
+        return {removed.face.ToAny(), removed.holder.ToAny()};
+    }
+};
+
+namespace xdata {
+
+namespace detail {
+
+    // Two bits of a 64 bit bloom mask, TypeUid is a well mixed hash so its own bits are used
+    constexpr uint64_t FilterBloomBits(uint64_t _uid) { return (1ull << (_uid & 63)) | (1ull << ((_uid >> 6) & 63)); }
+
+    template <size_t N>
+    constexpr std::array<uint64_t, N> FilterSorted(std::array<uint64_t, N> _uids)
+    {
+        for (size_t i = 1; i < N; ++i) {
+            for (size_t j = i; j > 0 && _uids[j] < _uids[j - 1]; --j) {
+                auto tmp     = _uids[j];
+                _uids[j]     = _uids[j - 1];
+                _uids[j - 1] = tmp;
+            }
+        }
+        return _uids;
+    }
+
+    template <size_t N>
+    constexpr uint64_t FilterBloom(const std::array<uint64_t, N>& _uids)
+    {
+        uint64_t bloom = 0;
+        for (size_t i = 0; i < N; ++i)
+            bloom |= FilterBloomBits(_uids[i]);
+        return bloom;
+    }
+
+    // Hashes sorted UIDs, the same as the runtime built filter does for a set
+    template <size_t N>
+    constexpr uint64_t FilterKey(const std::array<uint64_t, N>& _uids, IData::CloneSetType _set_type)
+    {
+        uint64_t key = static_cast<uint64_t>(_set_type);
+        for (size_t i = 0; i < N; ++i) {
+            if (i == 0 || _uids[i] != _uids[i - 1])
+                key = xbase::HashCombine(key, _uids[i]);
+        }
+        return key;
+    }
+
+    template <typename... TTypes>
+    struct TypeFilterOf {
+        static constexpr std::array<uint64_t, sizeof...(TTypes)> kUids =
+            FilterSorted(std::array<uint64_t, sizeof...(TTypes)> {xbase::TypeUid<TTypes>()...});
+        static constexpr uint64_t kBloom      = FilterBloom(kUids);
+        static constexpr uint64_t kKeyInclude = FilterKey(kUids, IData::CloneSetType::Include);
+        static constexpr uint64_t kKeyExclude = FilterKey(kUids, IData::CloneSetType::Exclude);
+    };
+
+} // namespace detail
+
+/**
+ * @brief Immutable precompiled filter of types for IData::Clone(), IData::CloneInto() and IData::Fingerprint().
+ *
+ * The UIDs are kept in a sorted array with a 64 bit bloom mask in front of it, so most of not selected UIDs are
+ * rejected by a single AND. Filters built by TypeFilter::Of() refer to the arrays computed at compile time and cost
+ * nothing to create or copy, filters built from a set share one allocation between copies.
+ * An empty filter in Exclude mode (the default) selects all the types, in Include mode selects nothing.
+ */
+class TypeFilter {
+public:
+    TypeFilter() = default;
+
+    /**
+     * @brief Build a filter from a set of UIDs.
+     * @param _types Set of types to include or exclude.
+     * @param _set_type Type of set to use. Exclude or include types from _types set.
+     */
+    explicit TypeFilter(const std::set<uint64_t>& _types,
+                        IData::CloneSetType       _set_type = IData::CloneSetType::Exclude)
+        : set_type_(_set_type),
+          key_(static_cast<uint64_t>(_set_type))
+    {
+        if (!_types.empty()) {
+            std::shared_ptr<uint64_t[]> uids_p(new uint64_t[_types.size()]);
+            std::copy(_types.begin(), _types.end(), uids_p.get());
+            uids_p_  = uids_p.get();
+            count_   = _types.size();
+            owner_p_ = std::move(uids_p);
+        }
+        for (size_t i = 0; i < count_; ++i) {
+            bloom_ |= detail::FilterBloomBits(uids_p_[i]);
+            key_    = xbase::HashCombine(key_, uids_p_[i]);
+        }
+    }
+
     /**
-     * @brief Remove all data from the data container by the given UID.
-     * @param _data_uid unique identifier for the data set entry
-     * @return True if something has been deleted, otherwise false
+     * @brief Build a filter from a type list, the filter data is computed at compile time.
+     * @tparam TTypes The types to include or exclude.
+     * @param _set_type Type of set to use. Exclude or include the types, always explicit as a type list reads like
+     * either mode.
+     * @return The filter.
+     */
+    template <typename... TTypes>
+    static TypeFilter Of(IData::CloneSetType _set_type) noexcept
+    {
+        using Data = detail::TypeFilterOf<std::decay_t<TTypes>...>;
+
+        TypeFilter filter;
+        filter.set_type_ = _set_type;
+        filter.uids_p_   = Data::kUids.data();
+        filter.count_    = Data::kUids.size();
+        filter.bloom_    = Data::kBloom;
+        filter.key_      = _set_type == IData::CloneSetType::Include ? Data::kKeyInclude : Data::kKeyExclude;
+        return filter;
+    }
+
+    /**
+     * @brief Check if the type is selected by the filter.
+     * @param _data_uid The type UID.
+     * @return True if the type is selected.
+     */
+    bool Match(uint64_t _data_uid) const noexcept
+    {
+        return Contains(_data_uid) == (set_type_ == IData::CloneSetType::Include);
+    }
+
+    /**
+     * @brief Check if the filter selects all the types (e.g. the default filter).
+     */
+    bool All() const noexcept { return !count_ && set_type_ == IData::CloneSetType::Exclude; }
+
+    /**
+     * @brief Hash of the filter, equal for the filters selecting the same types in the same way.
      */
-    virtual bool                          DataReset(uint64_t _data_uid)                                            = 0;
+    uint64_t Key() const noexcept { return key_; }
+
+    IData::CloneSetType SetType() const noexcept { return set_type_; }
+
+private:
+    bool Contains(uint64_t _data_uid) const noexcept
+    {
+        auto bits = detail::FilterBloomBits(_data_uid);
+        if ((bloom_ & bits) != bits)
+            return false;
+
+        if (count_ <= 8)
+            return std::find(uids_p_, uids_p_ + count_, _data_uid) != uids_p_ + count_;
+        return std::binary_search(uids_p_, uids_p_ + count_, _data_uid);
+    }
+
+private:
+    std::shared_ptr<const uint64_t[]> owner_p_;
+    const uint64_t*                   uids_p_   = nullptr;
+    size_t                            count_    = 0;
+    uint64_t                          bloom_    = 0;
+    IData::CloneSetType               set_type_ = IData::CloneSetType::Exclude;
+    uint64_t                          key_      = static_cast<uint64_t>(IData::CloneSetType::Exclude);
 };
 
+} // namespace xdata
+
+inline IData::UPtr IData::Clone(const std::set<uint64_t>& _cloned_types, CloneSetType _set_type) const
+{
+    return Clone(xdata::TypeFilter(_cloned_types, _set_type));
+}
+
+inline void IData::CloneInto(IData& _dst, const std::set<uint64_t>& _cloned_types, CloneSetType _set_type) const
+{
+    CloneInto(_dst, xdata::TypeFilter(_cloned_types, _set_type));
+}
+
+inline uint64_t IData::Fingerprint(const std::set<uint64_t>& _types, CloneSetType _set_type) const
+{
+    return Fingerprint(xdata::TypeFilter(_types, _set_type));
+}
+
 namespace xdata {
 
 /**
  * @brief Creates an empty XData
- * @return std::unique_ptr to the newly created XData
+ * @return std::unique_ptr to the newly created XData, see XData::Create() for get the concrete type
  */
 IData::UPtr Create(); // Implemetation in xdata_impl.cpp
 
@@ -91,6 +407,7 @@ IData::UPtr Create(); // Implemetation in xdata_impl.cpp
 template <typename TData>
 std::any AnyWrap(TData&& _data)
 {
+    (void)detail::TypeOpsOf<std::decay_t<TData>>::kAnyRegistered;
     return std::make_shared<std::decay_t<TData>>(std::forward<TData>(_data));
 }
 
@@ -103,8 +420,107 @@ std::any AnyWrap(TData&& _data)
 template <typename TData>
 const TData* AnyUnwrap(const std::any& _data)
 {
-    const auto* data_pp = std::any_cast<std::shared_ptr<TData>>(&_data);
-    return data_pp ? data_pp->get() : nullptr;
+    if (const auto* data_pp = std::any_cast<std::shared_ptr<TData>>(&_data))
+        return data_pp->get();
+
+    // Shared const instances (e.g. xdata::Intern()) are stored as const
+    const auto* const_pp = std::any_cast<std::shared_ptr<const TData>>(&_data);
+    return const_pp ? const_pp->get() : nullptr;
+}
+
+/**
+ * @brief Register memory estimation function for a type.
+ * By default the size of the boxed type (sizeof) is used, types which own dynamic memory (strings, buffers, etc.)
+ * should register own estimation for get meaningful DataMemoryUsage() and budgets.
+ * @param _type_uid TypeUid of the type.
+ * @param _sizer Function returning estimated size in bytes of the value pointed by argument, empty for unregister.
+ */
+void SizerRegister(uint64_t _type_uid, std::function<size_t(const void*)> _sizer); // Implemetation in xdata_types.cpp
+
+/**
+ * @brief Register memory estimation function for a type.
+ * @tparam TFace The data type.
+ * @param _sizer Function returning estimated size in bytes of the value.
+ */
+template <typename TFace>
+void SizerRegister(std::function<size_t(const TFace&)> _sizer)
+{
+    if (!_sizer) {
+        SizerRegister(xbase::TypeUid<TFace>(), nullptr);
+        return;
+    }
+
+    SizerRegister(xbase::TypeUid<TFace>(), [sizer = std::move(_sizer)](const void* _value_p) {
+        return sizer(*static_cast<const TFace*>(_value_p));
+    });
+}
+
+/**
+ * @brief Get estimated memory retained by the boxed value.
+ * @param _box The box to estimate.
+ * @return Size returned by the registered sizer or the size of the boxed type, 0 for an empty or lazy box.
+ */
+size_t SizeEstimate(const Box& _box); // Implemetation in xdata_types.cpp
+
+/**
+ * @brief Register hash function for a type, used by IData::Fingerprint().
+ * By default values are hashed by content: null-terminated strings (e.g. const char*) by their characters, floating
+ * point values with 0.0 and -0.0 (and all NaNs) treated as equal, other types by std::hash if it's available, or as
+ * raw bytes if the type has no padding (std::has_unique_object_representations), and ranges (e.g. std::vector) by
+ * their elements. Other types, including other pointers and smart pointers (their std::hash is the address), have no
+ * default hash and must register a hasher for being fingerprinted, see xdata::HashCompute().
+ * @param _type_uid TypeUid of the type.
+ * @param _hasher Function returning hash of the value pointed by argument, empty for unregister.
+ */
+void HasherRegister(uint64_t                             _type_uid,
+                    std::function<uint64_t(const void*)> _hasher); // Implemetation in xdata_types.cpp
+
+/**
+ * @brief Register hash function for a type, used by IData::Fingerprint().
+ * @tparam TFace The data type.
+ * @param _hasher Function returning hash of the value.
+ */
+template <typename TFace>
+void HasherRegister(std::function<uint64_t(const TFace&)> _hasher)
+{
+    if (!_hasher) {
+        HasherRegister(xbase::TypeUid<TFace>(), nullptr);
+        return;
+    }
+
+    HasherRegister(xbase::TypeUid<TFace>(), [hasher = std::move(_hasher)](const void* _value_p) {
+        return hasher(*static_cast<const TFace*>(_value_p));
+    });
+}
+
+/**
+ * @brief Get hash of the boxed value.
+ * Asserts for a typed value without registered or default hasher, such value is never hashed by identity, because
+ * equal values would give different hashes and a reused address could match a stale one.
+ * @param _box The box to hash, lazy value is computed.
+ * @return Hash returned by the registered hasher or by the default one, 0 for an empty box or a box without hash
+ * (a legacy std::any box or an unhashable type in release build), such boxes are skipped by IData::Fingerprint().
+ */
+uint64_t HashCompute(const Box& _box); // Implemetation in xdata_types.cpp
+
+/**
+ * @brief Get an entry by UID and index, checking the entry layout version.
+ * @param _xdata_p Pointer to the IData instance.
+ * @param _data_uid unique identifier for the data set entry
+ * @param _idx Index for the entry to get.
+ * @return Pointer to the entry owned by the container or nullptr if there is no such entry.
+ */
+inline const Entry* EntryGet(const IData* _xdata_p, uint64_t _data_uid, size_t _idx = 0)
+{
+    if (!_xdata_p)
+        return nullptr;
+
+    const auto* entry_p = _xdata_p->DataGetEntry(_data_uid, _idx);
+    if (!entry_p || entry_p->version != kEntryVersion) {
+        assert(!entry_p && "xdata::Entry layout mismatch");
+        return nullptr;
+    }
+    return entry_p;
 }
 
 // Use xdata::Set(data_p, -1, "123") for add new data, return index of added data
@@ -123,7 +539,9 @@ size_t Set(IData* _xdata_p, size_t _idx, TFace&& _face)
         return -1;
 
     using Face = std::decay_t<TFace>;
-    return _xdata_p->DataSet(xbase::TypeUid<Face>(), std::make_shared<Face>(std::forward<TFace>(_face)), {}, _idx);
+    return _xdata_p->DataSetEntry(xbase::TypeUid<Face>(),
+                                  Entry(Box(std::make_shared<Face>(std::forward<TFace>(_face))), Box()),
+                                  _idx);
 }
 /**
  * @brief Set a single data item with an additional holder.
@@ -141,10 +559,10 @@ size_t Set(IData* _xdata_p, size_t _idx, TFace&& _face, std::any&& _holder)
         return -1;
 
     using Face = std::decay_t<TFace>;
-    return _xdata_p->DataSet(xbase::TypeUid<Face>(),
-                             std::make_shared<Face>(std::forward<TFace>(_face)),
-                             std::move(_holder),
-                             _idx);
+    return _xdata_p->DataSetEntry(
+        xbase::TypeUid<Face>(),
+        Entry(Box(std::make_shared<Face>(std::forward<TFace>(_face))), Box::FromAny(std::move(_holder))),
+        _idx);
 }
 
 /**
@@ -165,10 +583,36 @@ size_t Set(IData* _xdata_p, size_t _idx, TFace&& _face, THolder&& _holder)
 
     using Face   = std::decay_t<TFace>;
     using Holder = std::decay_t<THolder>;
-    return _xdata_p->DataSet(xbase::TypeUid<Face>(),
-                             std::make_shared<Face>(std::forward<TFace>(_face)),
-                             std::make_shared<Holder>(std::forward<THolder>(_holder)),
-                             _idx);
+    return _xdata_p->DataSetEntry(xbase::TypeUid<Face>(),
+                                  Entry(Box(std::make_shared<Face>(std::forward<TFace>(_face))),
+                                        Box(std::make_shared<Holder>(std::forward<THolder>(_holder)))),
+                                  _idx);
+}
+
+/**
+ * @brief Set a single data item computed on the first access.
+ * The factory is called once on the first xdata::Get() (or other access) of the item, even if several threads read it
+ * at the same time, and the result is cached in place. Clone() shares the pending factory, so the value is computed
+ * once for the original and all its clones.
+ * The size of the value is unknown until it's computed, so lazy items are not accounted (their face is estimated as 0
+ * bytes, see xdata::SizeEstimate()) and are never evicted by the memory budget, even after the value is computed.
+ * @tparam TFace The data type to set.
+ * @tparam TFactory Callable without arguments returning TFace.
+ * @param _xdata_p Pointer to the IData instance.
+ * @param _idx Index for the data to set.
+ * @param _factory Factory of the data.
+ * @return Index of the added data if successful, otherwise -1.
+ */
+template <typename TFace, typename TFactory>
+size_t SetLazy(IData* _xdata_p, size_t _idx, TFactory&& _factory)
+{
+    if (!_xdata_p)
+        return -1;
+
+    using Face = std::decay_t<TFace>;
+    return _xdata_p->DataSetEntry(xbase::TypeUid<Face>(),
+                                  Entry(Box::Lazy<Face>(std::forward<TFactory>(_factory)), Box()),
+                                  _idx);
 }
 
 /**
@@ -186,6 +630,20 @@ size_t Count(const IData* _xdata_p)
     return _xdata_p->DataCount(xbase::TypeUid<std::decay_t<TFace>>());
 }
 
+/**
+ * @brief Get a raw pointer to an item by index and its type, without touching the reference counter.
+ * @tparam TFace The data type to get.
+ * @param _xdata_p Pointer to the IData instance.
+ * @param _idx Index for the data to get.
+ * @return Pointer valid until the container is modified, or a null pointer if there is no such item.
+ */
+template <typename TFace>
+const TFace* Peek(const IData* _xdata_p, size_t _idx = 0)
+{
+    const Entry* entry_p = EntryGet(_xdata_p, xbase::TypeUid<std::decay_t<TFace>>(), _idx);
+    return entry_p ? entry_p->face.Peek<TFace>() : nullptr;
+}
+
 /**
  * @brief Get a item by index and its type data type.
  * @tparam TFace The data type to get.
@@ -197,18 +655,18 @@ size_t Count(const IData* _xdata_p)
 template <typename TFace>
 std::shared_ptr<const TFace> Get(const IData* _xdata_p, size_t _idx = 0, std::any* _holder_get = nullptr)
 {
-    if (!_xdata_p)
+    const Entry* entry_p = EntryGet(_xdata_p, xbase::TypeUid<std::decay_t<TFace>>(), _idx);
+    if (!entry_p)
         return nullptr;
 
-    auto [face, holder] = _xdata_p->DataGet(xbase::TypeUid<TFace>(), _idx);
-    const auto* face_pp = std::any_cast<std::shared_ptr<TFace>>(&face);
-    if (!face_pp)
+    auto face_p = entry_p->face.Get<TFace>();
+    if (!face_p)
         return nullptr;
 
     if (_holder_get)
-        *_holder_get = std::move(holder);
+        *_holder_get = entry_p->holder.ToAny();
 
-    return *face_pp;
+    return face_p;
 }
 /**
  * @brief Get a copy of item which was retrieved by index and its type data type.
@@ -221,11 +679,15 @@ std::shared_ptr<const TFace> Get(const IData* _xdata_p, size_t _idx = 0, std::an
 template <typename TFace>
 TFace GetCopy(const IData* _xdata_p, size_t _idx = 0, std::any* _holder_get = nullptr)
 {
-    auto data_p = Get<TFace>(_xdata_p, _idx, _holder_get);
-    if (!data_p)
+    const Entry* entry_p = EntryGet(_xdata_p, xbase::TypeUid<std::decay_t<TFace>>(), _idx);
+    const auto*  face_p  = entry_p ? entry_p->face.Peek<TFace>() : nullptr;
+    if (!face_p)
         return {};
 
-    return *data_p;
+    if (_holder_get)
+        *_holder_get = entry_p->holder.ToAny();
+
+    return *face_p;
 }
 /**
  * @brief Get all elements of the same type as a vector.
@@ -244,10 +706,15 @@ std::vector<TFace> GetCopyVec(const IData* _xdata_p, std::any* _holder_get = nul
     std::vector<TFace> data_vec;
     data_vec.reserve(data_count);
     for (size_t z = 0; z < data_count; ++z) {
-        auto data_p = Get<TFace>(_xdata_p, z, (_holder_get && !_holder_get->has_value()) ? _holder_get : nullptr);
-        assert(data_p);
-        if (data_p)
-            data_vec.push_back(*data_p);
+        const Entry* entry_p = EntryGet(_xdata_p, xbase::TypeUid<std::decay_t<TFace>>(), z);
+        const auto*  face_p  = entry_p ? entry_p->face.Peek<TFace>() : nullptr;
+        assert(face_p);
+        if (!face_p)
+            continue;
+
+        if (_holder_get && !_holder_get->has_value())
+            *_holder_get = entry_p->holder.ToAny();
+        data_vec.push_back(*face_p);
     }
     return data_vec;
 }
@@ -264,15 +731,139 @@ template <typename TFace, typename THolder>
 std::pair<std::shared_ptr<const TFace>, std::shared_ptr<const THolder>> GetWithHolder(const IData* _xdata_p,
                                                                                       size_t              _idx = 0)
 {
-    if (!_xdata_p)
+    const Entry* entry_p = EntryGet(_xdata_p, xbase::TypeUid<std::decay_t<TFace>>(), _idx);
+    if (!entry_p)
         return {};
 
-    auto [face, holder]   = _xdata_p->DataGet(xbase::TypeUid<TFace>(), _idx);
-    const auto* face_pp   = std::any_cast<std::shared_ptr<TFace>>(&face);
-    const auto* holder_pp = std::any_cast<std::shared_ptr<THolder>>(&holder);
-    return {face_pp ? *face_pp : nullptr, holder_pp ? *holder_pp : nullptr};
+    return {entry_p->face.Get<TFace>(), entry_p->holder.Get<THolder>()};
+}
+
+/**
+ * @brief Name of a data slot, used for storing several values of the same type under different names.
+ *
+ * The name is hashed by xbase::HashString and combined with the TypeUid of the stored type, so a named slot is just
+ * another UID of the IData container. With the "name"_key literal the UID is a compile-time constant and the lookup
+ * cost is the same as for unnamed data.
+ */
+struct Key {
+    /**
+     * @brief Hash of the slot name.
+     */
+    uint64_t name_hash;
+
+    /**
+     * @brief Construct a key from a slot name.
+     * @param _name The slot name.
+     */
+    constexpr explicit Key(std::string_view _name) : name_hash(xbase::HashString(_name)) {}
+};
+
+inline namespace literals {
+
+    /**
+     * @brief Literal for named slot keys, e.g. xdata::Set(data_p, "pts"_key, -1, pts).
+     */
+    constexpr Key operator""_key(const char* _name, size_t _size) { return Key(std::string_view(_name, _size)); }
+
+} // namespace literals
+
+/**
+ * @brief Get a UID of the named slot for a given type.
+ * The returned UID can be used with IData methods directly, e.g. for Clone() or DataReset().
+ * @tparam TFace The data type stored in the slot.
+ * @param _key The slot key.
+ * @return The slot UID, a compile-time constant for constant keys.
+ */
+template <typename TFace>
+constexpr uint64_t KeyUid(Key _key) noexcept
+{
+    return xbase::HashCombine(xbase::TypeUid<std::decay_t<TFace>>(), _key.name_hash);
+}
+
+/**
+ * @brief Set a single data item into the named slot.
+ * @tparam TFace The data type to set.
+ * @param _xdata_p Pointer to the IData instance.
+ * @param _key The slot key.
+ * @param _idx Index for the data to set.
+ * @param _face Data instance to set.
+ * @return Index of the added data if successful, otherwise -1.
+ */
+template <typename TFace>
+size_t Set(IData* _xdata_p, Key _key, size_t _idx, TFace&& _face)
+{
+    if (!_xdata_p)
+        return -1;
+
+    using Face = std::decay_t<TFace>;
+    return _xdata_p->DataSetEntry(KeyUid<Face>(_key),
+                                  Entry(Box(std::make_shared<Face>(std::forward<TFace>(_face))), Box()),
+                                  _idx);
+}
+
+/**
+ * @brief Get count of elements in the named slot.
+ * @tparam TFace The data type to get the count for.
+ * @param _xdata_p Pointer to the IData instance.
+ * @param _key The slot key.
+ * @return Data count if successful, otherwise 0.
+ */
+template <typename TFace>
+size_t Count(const IData* _xdata_p, Key _key)
+{
+    if (!_xdata_p)
+        return 0;
+
+    return _xdata_p->DataCount(KeyUid<TFace>(_key));
 }
 
+/**
+ * @brief Get a raw pointer to an item of the named slot, without touching the reference counter.
+ * @tparam TFace The data type to get.
+ * @param _xdata_p Pointer to the IData instance.
+ * @param _key The slot key.
+ * @param _idx Index for the data to get.
+ * @return Pointer valid until the container is modified, or a null pointer if there is no such item.
+ */
+template <typename TFace>
+const TFace* Peek(const IData* _xdata_p, Key _key, size_t _idx = 0)
+{
+    const Entry* entry_p = EntryGet(_xdata_p, KeyUid<TFace>(_key), _idx);
+    return entry_p ? entry_p->face.Peek<TFace>() : nullptr;
+}
+
+/**
+ * @brief Get an item of the named slot.
+ * @tparam TFace The data type to get.
+ * @param _xdata_p Pointer to the IData instance.
+ * @param _key The slot key.
+ * @param _idx Index for the data to get.
+ * @return A pointer to the data if successful, otherwise a null pointer.
+ */
+template <typename TFace>
+std::shared_ptr<const TFace> Get(const IData* _xdata_p, Key _key, size_t _idx = 0)
+{
+    const Entry* entry_p = EntryGet(_xdata_p, KeyUid<TFace>(_key), _idx);
+    return entry_p ? entry_p->face.Get<TFace>() : nullptr;
+}
+
+/**
+ * @brief Get a copy of an item of the named slot.
+ * @tparam TFace The data type to get and copy.
+ * @param _xdata_p Pointer to the IData instance.
+ * @param _key The slot key.
+ * @param _idx Index for the data to get and copy.
+ * @return A copy of the data if successful, otherwise a default value.
+ */
+template <typename TFace>
+TFace GetCopy(const IData* _xdata_p, Key _key, size_t _idx = 0)
+{
+    const auto* face_p = Peek<TFace>(_xdata_p, _key, _idx);
+    if (!face_p)
+        return {};
+
+    return *face_p;
+}
 
 } // namespace xdata
 } // namespace xsdk
\ No newline at end of file
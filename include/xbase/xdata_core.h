@@ -0,0 +1,252 @@
+#pragma once
+
+#include "xdata.h"
+#include "xdata_slot.h"
+
+#include <map>
+#include <type_traits>
+#include <utility>
+
+namespace xsdk {
+
+/**
+ * @brief The default IData container, the same as created by xdata::Create().
+ *
+ * The class is final and the hot methods (DataSetEntry, DataGetEntry, DataCount) are defined in the header, so calls
+ * through XData pointer (including the xdata:: helpers overloads taking it) are devirtualized and can be inlined.
+ */
+class XData final: public IData {
+public:
+    USING_PTRS(XData)
+
+    /**
+     * @brief Creates an empty XData
+     * @return std::unique_ptr to the newly created XData
+     */
+    static UPtr Create() { return std::make_unique<XData>(); }
+
+    XData() = default;
+
+    //-------------------------------------------------------------------------------
+    // Typed accessors
+
+    /**
+     * @brief Get count of elements of the same type.
+     * @tparam TFace The data type to get the count for.
+     * @return Data count.
+     */
+    template <typename TFace>
+    size_t Count() const
+    {
+        return DataCount(xbase::TypeUid<std::decay_t<TFace>>());
+    }
+
+    /**
+     * @brief Get an entry by its type.
+     * @tparam TFace The data type of the entry.
+     * @param _idx Index of the entry.
+     * @return Pointer to the entry valid until the container is modified, or nullptr if there is no such entry.
+     */
+    template <typename TFace>
+    const xdata::Entry* EntryAt(size_t _idx = 0) const
+    {
+        return DataGetEntry(xbase::TypeUid<std::decay_t<TFace>>(), _idx);
+    }
+
+    /**
+     * @brief Set an item by its type.
+     * @tparam TFace The data type to set.
+     * @param _idx Index for the data to set, -1 for add new one.
+     * @param _entry Entry to set.
+     * @return Index of the set item.
+     */
+    template <typename TFace>
+    size_t SetEntry(size_t _idx, xdata::Entry&& _entry)
+    {
+        return DataSetEntry(xbase::TypeUid<std::decay_t<TFace>>(), std::move(_entry), _idx);
+    }
+
+    /**
+     * @brief Remove the memory budget and all the per-UID eviction policies, e.g. for a recycled container.
+     */
+    void BudgetReset() { budget_.SettingsReset(); }
+
+    //-------------------------------------------------------------------------------
+    // IData
+
+    using IData::Clone;
+    using IData::CloneInto;
+    using IData::Fingerprint;
+
+    IData::UPtr Clone(const xdata::TypeFilter& _filter) const override;
+    void        CloneInto(IData& _dst, const xdata::TypeFilter& _filter) const override;
+    void        Clear() override;
+
+    IData::SPtrC Freeze() const override;
+
+    size_t DataSetEntry(uint64_t _data_uid, xdata::Entry&& _entry, size_t _idx = 0) override
+    {
+        //std::unique_lock lck(map_rw_);
+
+        auto it = data_map_.try_emplace(_data_uid).first;
+        return budget_.Store(it->second, _idx, std::move(_entry), [this](auto&& _func) { SlotsForEach(_func); });
+    }
+
+    size_t DataCount(uint64_t _data_uid) const override
+    {
+        //std::shared_lock lck(map_rw_);
+
+        auto it = data_map_.find(_data_uid);
+        return it == data_map_.end() ? 0 : it->second.Size();
+    }
+
+    const xdata::Entry* DataGetEntry(uint64_t _data_uid, size_t _idx = 0) const override
+    {
+        //std::shared_lock lck(map_rw_);
+
+        auto it = data_map_.find(_data_uid);
+        if (it == data_map_.end())
+            return nullptr;
+
+        return budget_.Touch(_data_uid, it->second.At(_idx));
+    }
+
+    xdata::Entry DataRemoveEntry(uint64_t _data_uid, size_t _idx = 0) override;
+    bool         DataReset(uint64_t _data_uid) override;
+
+    size_t DataMemoryUsage() const override { return budget_.Usage(); }
+    void   DataBudgetSet(size_t _max_bytes, EvictPolicy _policy = EvictPolicy::OldestFirst) override
+    {
+        budget_.Set(_max_bytes, _policy);
+    }
+
+    void DataBudgetPolicySet(uint64_t _data_uid, EvictPolicy _policy) override
+    {
+        budget_.PolicySet(_data_uid, _policy);
+    }
+
+    uint64_t Fingerprint(const xdata::TypeFilter& _filter) const override;
+
+private:
+    template <typename TFunc>
+    void SlotsForEach(TFunc&& _func)
+    {
+        for (auto& [type, val] : data_map_)
+            _func(type, val);
+    }
+
+private:
+    // Slots are kept by Clear() for reuse of their storage until the next Clear(), so the map may contain empty slots
+    std::map<uint64_t, xdata::detail::EntrySlot> data_map_;
+    xdata::detail::MemoryBudget                  budget_;
+    xdata::detail::FingerprintCache              fingerprint_;
+};
+
+namespace xdata {
+
+namespace detail {
+
+    /**
+     * @brief Concrete final IData implementations with typed accessors (Count, EntryAt, SetEntry), the xdata:: helpers
+     * have overloads for them without virtual calls.
+     */
+    template <typename TData>
+    struct IsConcrete: std::false_type {};
+
+    template <>
+    struct IsConcrete<XData>: std::true_type {};
+
+    template <typename TData>
+    using EnableIfConcrete = std::enable_if_t<IsConcrete<std::remove_cv_t<TData>>::value>;
+
+} // namespace detail
+
+//-------------------------------------------------------------------------------
+// xdata:: helpers overloads for the concrete containers (XData, Record)
+
+/**
+ * @brief Set a single data item.
+ * @tparam TFace The data type to set.
+ * @param _xdata_p Pointer to the concrete container.
+ * @param _idx Index for the data to set.
+ * @param _face Data instance to set.
+ * @return Index of the added data if successful, otherwise -1.
+ */
+template <typename TFace, typename TData, typename = detail::EnableIfConcrete<TData>>
+size_t Set(TData* _xdata_p, size_t _idx, TFace&& _face)
+{
+    if (!_xdata_p)
+        return -1;
+
+    using Face = std::decay_t<TFace>;
+    return _xdata_p->template SetEntry<Face>(_idx,
+                                             Entry(Box(std::make_shared<Face>(std::forward<TFace>(_face))), Box()));
+}
+
+/**
+ * @brief Get count of elements of the same type.
+ * @tparam TFace The data type to get the count for.
+ * @param _xdata_p Pointer to the concrete container.
+ * @return Data count if successful, otherwise 0.
+ */
+template <typename TFace, typename TData, typename = detail::EnableIfConcrete<TData>>
+size_t Count(const TData* _xdata_p)
+{
+    return _xdata_p ? _xdata_p->template Count<TFace>() : 0;
+}
+
+/**
+ * @brief Get a raw pointer to an item, without touching the reference counter.
+ * @tparam TFace The data type to get.
+ * @param _xdata_p Pointer to the concrete container.
+ * @param _idx Index for the data to get.
+ * @return Pointer valid until the container is modified, or a null pointer if there is no such item.
+ */
+template <typename TFace, typename TData, typename = detail::EnableIfConcrete<TData>>
+const TFace* Peek(const TData* _xdata_p, size_t _idx = 0)
+{
+    const Entry* entry_p = _xdata_p ? _xdata_p->template EntryAt<TFace>(_idx) : nullptr;
+    return entry_p ? entry_p->face.Peek<TFace>() : nullptr;
+}
+
+/**
+ * @brief Get an item.
+ * @tparam TFace The data type to get.
+ * @param _xdata_p Pointer to the concrete container.
+ * @param _idx Index for the data to get.
+ * @param[out] _holder_get A pointer to the holder to be filled with the holder, if any.
+ * @return A pointer to the data if successful, otherwise a null pointer.
+ */
+template <typename TFace, typename TData, typename = detail::EnableIfConcrete<TData>>
+std::shared_ptr<const TFace> Get(const TData* _xdata_p, size_t _idx = 0, std::any* _holder_get = nullptr)
+{
+    const Entry* entry_p = _xdata_p ? _xdata_p->template EntryAt<TFace>(_idx) : nullptr;
+    if (!entry_p)
+        return nullptr;
+
+    auto face_p = entry_p->face.Get<TFace>();
+    if (face_p && _holder_get)
+        *_holder_get = entry_p->holder.ToAny();
+
+    return face_p;
+}
+
+/**
+ * @brief Get a copy of an item.
+ * @tparam TFace The data type to get and copy.
+ * @param _xdata_p Pointer to the concrete container.
+ * @param _idx Index for the data to get and copy.
+ * @return A copy of the data if successful, otherwise a default value.
+ */
+template <typename TFace, typename TData, typename = detail::EnableIfConcrete<TData>>
+TFace GetCopy(const TData* _xdata_p, size_t _idx = 0)
+{
+    const auto* face_p = Peek<TFace>(_xdata_p, _idx);
+    if (!face_p)
+        return {};
+
+    return *face_p;
+}
+
+} // namespace xdata
+} // namespace xsdk
@@ -0,0 +1,542 @@
+#pragma once
+
+#include "xuid.h"
+
+#include <any>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace xsdk::xdata {
+
+/**
+ * @brief Layout version of xdata::Entry.
+ *
+ * Stored in every entry and checked by the xdata:: helpers, so a container built against another layout is
+ * detected instead of being misread.
+ */
+constexpr uint32_t kEntryVersion = 5;
+
+/**
+ * @brief Per-type operations shared by all boxes holding the same type.
+ */
+struct TypeOps {
+    /**
+     * @brief TypeUid of the boxed type (const/volatile removed).
+     */
+    xbase::Uid type_uid;
+    /**
+     * @brief Default memory estimation of the boxed value, see xdata::SizerRegister().
+     */
+    size_t     size_of;
+    /**
+     * @brief Convert the boxed pointer back to the legacy std::any representation.
+     */
+    std::any (*to_any)(const std::shared_ptr<const void>& _ptr);
+    /**
+     * @brief Get the pointer from std::any holding std::shared_ptr of the type, see Box::FromAny().
+     * Sets _ops_pp to the operations preserving constness of the pointer for to_any.
+     */
+    std::shared_ptr<const void> (*from_any)(const std::any& _any, const TypeOps** _ops_pp);
+    /**
+     * @brief Default hash of the boxed value, see xdata::HasherRegister(), nullptr if the type has no default hash.
+     */
+    uint64_t (*hash)(const void* _value_p);
+    /**
+     * @brief True if the box holds detail::LazyCell computing the value instead of the value itself.
+     */
+    bool lazy;
+};
+
+namespace detail {
+
+    /**
+     * @brief Marker type for boxes wrapping a std::any received through the legacy IData methods.
+     */
+    struct LegacyAny {};
+
+    /**
+     * @brief Value computed on the first access, exactly once even for concurrent readers.
+     */
+    class LazyCell {
+    public:
+        explicit LazyCell(std::function<std::shared_ptr<const void>()>&& _factory) : factory_(std::move(_factory))
+        {
+        }
+
+        const std::shared_ptr<const void>& Value() const
+        {
+            // If the factory throws, the next access calls it again
+            std::call_once(once_, [this] {
+                value_   = factory_();
+                factory_ = nullptr;
+            });
+            return value_;
+        }
+
+    private:
+        mutable std::once_flag                               once_;
+        mutable std::function<std::shared_ptr<const void>()> factory_;
+        mutable std::shared_ptr<const void>                  value_;
+    };
+
+    /**
+     * @brief Register the operations for recognizing values of the type in std::any, see Box::FromAny().
+     * Called once per type which is boxed anywhere in the program.
+     * Implemetation in xdata_types.cpp
+     */
+    bool AnyOpsRegister(const TypeOps* _ops_p);
+
+    /**
+     * @brief Find the operations registered by AnyOpsRegister().
+     * Implemetation in xdata_types.cpp
+     */
+    const TypeOps* AnyOpsFind(xbase::Uid _type_uid);
+
+    template <typename T, typename = void>
+    struct IsStdHashable: std::false_type {};
+
+    template <typename T>
+    struct IsStdHashable<T, std::void_t<decltype(std::hash<T> {}(std::declval<const T&>()))>>
+        : std::is_default_constructible<std::hash<T>> {};
+
+    template <typename T, typename = void>
+    struct IsRange: std::false_type {};
+
+    template <typename T>
+    struct IsRange<T, std::void_t<decltype(std::begin(std::declval<const T&>()) != std::end(std::declval<const T&>()))>>
+        : std::true_type {};
+
+    template <typename T>
+    using RangeValue = std::decay_t<decltype(*std::begin(std::declval<const T&>()))>;
+
+    template <typename T>
+    struct IsSmartPointer: std::false_type {};
+
+    template <typename T>
+    struct IsSmartPointer<std::shared_ptr<T>>: std::true_type {};
+
+    template <typename T>
+    struct IsSmartPointer<std::weak_ptr<T>>: std::true_type {};
+
+    template <typename T, typename TDeleter>
+    struct IsSmartPointer<std::unique_ptr<T, TDeleter>>: std::true_type {};
+
+    // Null-terminated strings, e.g. stored by xdata::Set(data_p, -1, "123")
+    template <typename T>
+    constexpr bool IsCString()
+    {
+        if constexpr (std::is_pointer_v<T>) {
+            using Char = std::remove_cv_t<std::remove_pointer_t<T>>;
+            return std::is_same_v<Char, char> || std::is_same_v<Char, wchar_t> || std::is_same_v<Char, char16_t> ||
+                   std::is_same_v<Char, char32_t>;
+        }
+        else
+            return false;
+    }
+
+    // Values which may be hashed by content: strings, floating point, types with std::hash, types without padding
+    // and ranges of such types (e.g. std::vector<int>). Pointers (other than strings) and smart pointers have only
+    // the identity, so they are not hashable by default.
+    template <typename T>
+    constexpr bool IsDefaultHashable()
+    {
+        if constexpr (IsCString<T>() || std::is_floating_point_v<T>)
+            return true;
+        else if constexpr (std::is_pointer_v<T> || std::is_member_pointer_v<T> || IsSmartPointer<T>::value)
+            return false;
+        else if constexpr (IsStdHashable<T>::value || std::has_unique_object_representations_v<T>)
+            return true;
+        else if constexpr (IsRange<T>::value) {
+            // Ranges of itself (e.g. std::filesystem::path) would recurse infinitely
+            if constexpr (std::is_same_v<RangeValue<T>, T>)
+                return false;
+            else
+                return IsDefaultHashable<RangeValue<T>>();
+        }
+        else
+            return false;
+    }
+
+    // Follows the order of IsDefaultHashable(), equal values give equal hashes
+    template <typename T>
+    uint64_t ValueHash(const T& _value)
+    {
+        if constexpr (IsCString<T>()) {
+            using View = std::basic_string_view<std::remove_cv_t<std::remove_pointer_t<T>>>;
+            return _value ? std::hash<View> {}(View(_value)) : 0;
+        }
+        else if constexpr (std::is_floating_point_v<T>) {
+            // 0.0 == -0.0, and all the NaNs are the same for hashing
+            if (_value != _value)
+                return ~uint64_t(0);
+            return std::hash<T> {}(_value == T(0) ? T(0) : _value);
+        }
+        else if constexpr (IsStdHashable<T>::value)
+            return std::hash<T> {}(_value);
+        else if constexpr (std::has_unique_object_representations_v<T>)
+            return xbase::HashString(std::string_view(reinterpret_cast<const char*>(&_value), sizeof(T)));
+        else {
+            uint64_t hash  = 0;
+            size_t   count = 0;
+            for (const auto& item : _value) {
+                hash = xbase::HashCombine(hash, ValueHash<RangeValue<T>>(item));
+                ++count;
+            }
+            return xbase::HashCombine(hash, count);
+        }
+    }
+
+    template <typename T>
+    uint64_t DefaultHash(const void* _value_p)
+    {
+        return ValueHash(*static_cast<const T*>(_value_p));
+    }
+
+    // Value hash is required for fingerprints, so there is no identity (address) fallback
+    template <typename T>
+    constexpr auto DefaultHashOf() -> uint64_t (*)(const void*)
+    {
+        if constexpr (IsDefaultHashable<T>())
+            return &DefaultHash<T>;
+        else
+            return nullptr;
+    }
+
+    template <typename T>
+    struct TypeOpsOf {
+        static std::any ToAny(const std::shared_ptr<const void>& _ptr)
+        {
+            // Legacy API stores non-const std::shared_ptr<T>
+            return std::const_pointer_cast<T>(std::static_pointer_cast<const T>(_ptr));
+        }
+
+        static std::any ConstToAny(const std::shared_ptr<const void>& _ptr)
+        {
+            return std::static_pointer_cast<const T>(_ptr);
+        }
+
+        static std::any LazyToAny(const std::shared_ptr<const void>& _ptr)
+        {
+            return ToAny(static_cast<const LazyCell*>(_ptr.get())->Value());
+        }
+
+        static std::shared_ptr<const void> FromAny(const std::any& _any, const TypeOps** _ops_pp);
+
+        static constexpr TypeOps kOps {xbase::TypeUid<T>(), sizeof(T), &ToAny, &FromAny, DefaultHashOf<T>(), false};
+        static constexpr TypeOps kConstOps {xbase::TypeUid<T>(),
+                                            sizeof(T),
+                                            &ConstToAny,
+                                            &FromAny,
+                                            DefaultHashOf<T>(),
+                                            false};
+        static constexpr TypeOps kLazyOps {xbase::TypeUid<T>(),
+                                           sizeof(T),
+                                           &LazyToAny,
+                                           &FromAny,
+                                           DefaultHashOf<T>(),
+                                           true};
+
+        // Odr-used by Box constructors, so every boxed type is recognized by Box::FromAny()
+        static inline const bool kAnyRegistered = AnyOpsRegister(&kOps);
+    };
+
+    template <typename T>
+    std::shared_ptr<const void> TypeOpsOf<T>::FromAny(const std::any& _any, const TypeOps** _ops_pp)
+    {
+        if (const auto* ptr_p = std::any_cast<std::shared_ptr<T>>(&_any)) {
+            *_ops_pp = &kOps;
+            return *ptr_p;
+        }
+        if (const auto* ptr_p = std::any_cast<std::shared_ptr<const T>>(&_any)) {
+            *_ops_pp = &kConstOps;
+            return *ptr_p;
+        }
+        return nullptr;
+    }
+
+    template <>
+    struct TypeOpsOf<LegacyAny> {
+        static std::any ToAny(const std::shared_ptr<const void>& _ptr)
+        {
+            return *std::static_pointer_cast<const std::any>(_ptr);
+        }
+
+        // Type of the wrapped value is unknown, so it can't be hashed, see HashCompute()
+        static constexpr TypeOps kOps {xbase::TypeUid<LegacyAny>(),
+                                       sizeof(std::any),
+                                       &ToAny,
+                                       nullptr,
+                                       nullptr,
+                                       false};
+    };
+
+} // namespace detail
+
+/**
+ * @brief Type-erased shared pointer tagged with the TypeUid of the pointee.
+ *
+ * Unlike std::any, the type check is a single integer comparison (no type_info involved), so it behaves the same
+ * across shared library boundaries, and std::shared_ptr<T> and std::shared_ptr<const T> are treated as the same type.
+ */
+class Box {
+public:
+    Box() = default;
+
+    /**
+     * @brief Box a shared pointer.
+     * @tparam T The boxed type, the box has the same type for T and const T, but the constness is kept for the
+     * legacy std::any representation (see ToAny()), so a shared const value (e.g. xdata::Intern()) can't be
+     * modified through the legacy API.
+     * @param _ptr Pointer to box, a null pointer gives an empty box.
+     */
+    template <typename T>
+    explicit Box(std::shared_ptr<T> _ptr)
+        : ops_(_ptr ? PtrOps<T>() : nullptr),
+          ptr_(std::move(_ptr))
+    {
+        (void)detail::TypeOpsOf<std::remove_cv_t<T>>::kAnyRegistered;
+    }
+
+    /**
+     * @brief Wrap a std::any received through the legacy IData methods.
+     *
+     * If _any holds std::shared_ptr<T> (or std::shared_ptr<const T>) of the expected type, and the type is boxed
+     * anywhere in the program (so its operations are registered), the pointer is boxed as is, like by Box(ptr).
+     * Otherwise the std::any itself is wrapped, such box is excluded from hashing (see IData::Fingerprint()).
+     * @param _any The value to wrap, an empty std::any gives an empty box.
+     * @param _type_uid TypeUid of the expected type, 0 if unknown.
+     * @return Box which can be unwrapped either by ToAny() or by the type stored in std::shared_ptr inside _any.
+     */
+    static Box FromAny(std::any&& _any, xbase::Uid _type_uid = 0)
+    {
+        if (!_any.has_value())
+            return {};
+
+        Box box;
+        if (const auto* ops_p = _type_uid ? detail::AnyOpsFind(_type_uid) : nullptr) {
+            box.ptr_ = ops_p->from_any(_any, &box.ops_);
+            if (box.ptr_)
+                return box;
+        }
+
+        box.ops_ = &detail::TypeOpsOf<detail::LegacyAny>::kOps;
+        box.ptr_ = std::make_shared<const std::any>(std::move(_any));
+        return box;
+    }
+
+    /**
+     * @brief Box a value computed on the first access.
+     * The factory is called once, on the first Peek(), Get(), Ptr() or ToAny() of this box or of any its copy,
+     * concurrent readers wait for the result. Copies of the box share the factory and the computed value.
+     * @tparam T The boxed type.
+     * @param _factory Callable returning the value (T or anything convertible to T).
+     * @return Box holding the pending value.
+     */
+    template <typename T, typename TFactory>
+    static Box Lazy(TFactory&& _factory)
+    {
+        using Face = std::remove_cv_t<T>;
+
+        (void)detail::TypeOpsOf<Face>::kAnyRegistered;
+
+        Box box;
+        box.ops_ = &detail::TypeOpsOf<Face>::kLazyOps;
+        box.ptr_ = std::make_shared<const detail::LazyCell>(
+            [factory = std::forward<TFactory>(_factory)]() mutable -> std::shared_ptr<const void> {
+                return std::make_shared<Face>(factory());
+            });
+        return box;
+    }
+
+    /**
+     * @brief Convert the box to the legacy std::any representation (std::any with std::shared_ptr<T>, or with
+     * std::shared_ptr<const T> if a const pointer was boxed).
+     * @return std::any with the boxed pointer or empty std::any for an empty box.
+     */
+    std::any ToAny() const { return ops_ ? ops_->to_any(ptr_) : std::any(); }
+
+    /**
+     * @brief Check if the box holds something.
+     */
+    bool HasValue() const noexcept { return ops_ != nullptr; }
+
+    /**
+     * @brief Check if the box holds a value computed on the first access, see Lazy().
+     * @return True for lazy box, even if the value is computed already.
+     */
+    bool IsLazy() const noexcept { return ops_ && ops_->lazy; }
+
+    /**
+     * @brief Get TypeUid of the boxed type.
+     * @return TypeUid of the boxed type or 0 for an empty box.
+     */
+    xbase::Uid TypeId() const noexcept { return ops_ ? ops_->type_uid : 0; }
+
+    /**
+     * @brief Get the operations of the boxed type.
+     * @return Pointer to the static operations table or nullptr for an empty box.
+     */
+    const TypeOps* Ops() const noexcept { return ops_; }
+
+    /**
+     * @brief Get a raw pointer to the boxed value without touching the reference counter.
+     * @tparam T The expected type.
+     * @return Pointer valid while the box is alive and unchanged, or nullptr if the type does not match.
+     */
+    template <typename T>
+    const T* Peek() const
+    {
+        using Face = std::remove_cv_t<T>;
+        if (!ops_)
+            return nullptr;
+
+        if (ops_->type_uid == xbase::TypeUid<Face>())
+            return static_cast<const Face*>(Ptr().get());
+
+        if (ops_->type_uid == xbase::TypeUid<detail::LegacyAny>())
+            return LegacyPeek<Face>();
+
+        return nullptr;
+    }
+
+    /**
+     * @brief Get a shared pointer to the boxed value.
+     * @tparam T The expected type.
+     * @return Shared pointer to the value or nullptr if the type does not match.
+     */
+    template <typename T>
+    std::shared_ptr<const T> Get() const
+    {
+        using Face = std::remove_cv_t<T>;
+        if (!ops_)
+            return nullptr;
+
+        if (ops_->type_uid == xbase::TypeUid<Face>())
+            return std::static_pointer_cast<const Face>(Ptr());
+
+        if (ops_->type_uid == xbase::TypeUid<detail::LegacyAny>())
+            return LegacyGet<Face>();
+
+        return nullptr;
+    }
+
+    /**
+     * @brief Get the type-erased boxed pointer, computes the lazy value if necessary.
+     */
+    const std::shared_ptr<const void>& Ptr() const
+    {
+        if (ops_ && ops_->lazy)
+            return static_cast<const detail::LazyCell*>(ptr_.get())->Value();
+        return ptr_;
+    }
+
+private:
+    template <typename T>
+    static const TypeOps* PtrOps() noexcept
+    {
+        using Face = std::remove_cv_t<T>;
+        return std::is_const_v<T> ? &detail::TypeOpsOf<Face>::kConstOps : &detail::TypeOpsOf<Face>::kOps;
+    }
+
+    template <typename Face>
+    const Face* LegacyPeek() const noexcept
+    {
+        const auto* any_p = static_cast<const std::any*>(ptr_.get());
+        if (const auto* face_pp = std::any_cast<std::shared_ptr<Face>>(any_p))
+            return face_pp->get();
+        if (const auto* face_pp = std::any_cast<std::shared_ptr<const Face>>(any_p))
+            return face_pp->get();
+        return nullptr;
+    }
+
+    template <typename Face>
+    std::shared_ptr<const Face> LegacyGet() const
+    {
+        const auto* any_p = static_cast<const std::any*>(ptr_.get());
+        if (const auto* face_pp = std::any_cast<std::shared_ptr<Face>>(any_p))
+            return *face_pp;
+        if (const auto* face_pp = std::any_cast<std::shared_ptr<const Face>>(any_p))
+            return *face_pp;
+        return nullptr;
+    }
+
+private:
+    const TypeOps*              ops_ = nullptr;
+    std::shared_ptr<const void> ptr_;
+};
+
+/**
+ * @brief Single IData entry: the value (face) and optional holder which keeps the value's resources alive.
+ */
+struct Entry {
+    /**
+     * @brief Layout version, see kEntryVersion.
+     */
+    uint32_t version = kEntryVersion;
+    /**
+     * @brief The stored value.
+     */
+    Box      face;
+    /**
+     * @brief The holder associated with the value (may be empty).
+     */
+    Box      holder;
+    /**
+     * @brief Estimated memory retained by the entry, filled by the container when the entry is stored.
+     */
+    size_t   bytes = 0;
+    /**
+     * @brief Container tick of the last store (or access for EvictPolicy::Lru), used for eviction.
+     */
+    mutable std::atomic<uint64_t> tick = {0};
+    /**
+     * @brief Cached hash of the face, computed on the first fingerprint calculation (0 if not computed).
+     */
+    mutable std::atomic<uint64_t> face_hash = {0};
+
+    Entry() = default;
+    Entry(Box&& _face, Box&& _holder) : face(std::move(_face)), holder(std::move(_holder)) {}
+
+    Entry(const Entry& _other)
+        : face(_other.face),
+          holder(_other.holder),
+          bytes(_other.bytes),
+          tick(_other.tick.load(std::memory_order_relaxed)),
+          face_hash(_other.face_hash.load(std::memory_order_relaxed))
+    {
+    }
+    Entry(Entry&& _other) noexcept
+        : face(std::move(_other.face)),
+          holder(std::move(_other.holder)),
+          bytes(_other.bytes),
+          tick(_other.tick.load(std::memory_order_relaxed)),
+          face_hash(_other.face_hash.load(std::memory_order_relaxed))
+    {
+    }
+    Entry& operator=(const Entry& _other)
+    {
+        face   = _other.face;
+        holder = _other.holder;
+        bytes  = _other.bytes;
+        tick.store(_other.tick.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        face_hash.store(_other.face_hash.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return *this;
+    }
+    Entry& operator=(Entry&& _other) noexcept
+    {
+        face   = std::move(_other.face);
+        holder = std::move(_other.holder);
+        bytes  = _other.bytes;
+        tick.store(_other.tick.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        face_hash.store(_other.face_hash.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return *this;
+    }
+};
+
+} // namespace xsdk::xdata
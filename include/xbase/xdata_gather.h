@@ -0,0 +1,144 @@
+#pragma once
+
+#include "xdata_core.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <typeinfo>
+#include <vector>
+
+namespace xsdk::xdata {
+
+namespace detail {
+
+    /**
+     * @brief Minimal count of the containers processed by one thread in Gather() and Scatter().
+     */
+    constexpr size_t kGatherGrain = 4096;
+
+    /**
+     * @brief Call the function for the sub-ranges of [0, _count), in parallel if the range is large enough.
+     * The sub-ranges are processed by the calling thread and by a persistent pool of worker threads (started on
+     * demand), if no worker can be started the calling thread processes everything. Rethrows the first exception
+     * thrown by the function.
+     * Implemetation in xdata_gather.cpp
+     * @param _count Size of the range.
+     * @param _grain Minimal size of the sub-range processed by one thread.
+     * @param _func Function called for the sub-ranges.
+     * @param _threads Maximal count of the threads including the calling one, 0 for hardware_concurrency().
+     */
+    void ParallelFor(size_t                                                 _count,
+                     size_t                                                 _grain,
+                     const std::function<void(size_t _begin, size_t _end)>& _func,
+                     size_t                                                 _threads = 0);
+
+    // XData is final, so the typeid() comparison is enough for check the concrete type and cheaper than dynamic_cast
+    inline const XData* AsConcrete(const IData* _xdata_p) noexcept
+    {
+        return _xdata_p && typeid(*_xdata_p) == typeid(XData) ? static_cast<const XData*>(_xdata_p) : nullptr;
+    }
+
+    inline XData* AsConcrete(IData* _xdata_p) noexcept
+    {
+        return _xdata_p && typeid(*_xdata_p) == typeid(XData) ? static_cast<XData*>(_xdata_p) : nullptr;
+    }
+
+} // namespace detail
+
+/**
+ * @brief Extract items of one type from many containers into a contiguous array.
+ *
+ * The items are copied without touching the reference counters, the XData containers are accessed without virtual
+ * calls. Large inputs are split between threads (see detail::kGatherGrain).
+ * @tparam TFace The data type to extract.
+ * @param _frames_p Array of the containers, may contain null pointers.
+ * @param _count Count of the containers.
+ * @param[out] _out_p Array of _count items to fill, items of the containers without the data are left unchanged.
+ * @param _idx Index of the item in each container.
+ * @param _threads Maximal count of the threads, 0 for std::thread::hardware_concurrency().
+ * @return Count of the extracted items.
+ */
+template <typename TFace>
+size_t Gather(const IData* const* _frames_p, size_t _count, TFace* _out_p, size_t _idx = 0, size_t _threads = 0)
+{
+    std::atomic<size_t> gathered = {0};
+    detail::ParallelFor(_count, detail::kGatherGrain, [&](size_t _begin, size_t _end) {
+        size_t found = 0;
+        for (size_t i = _begin; i < _end; ++i) {
+            const auto* concrete_p = detail::AsConcrete(_frames_p[i]);
+            const auto* face_p     = concrete_p ? Peek<TFace>(concrete_p, _idx) : Peek<TFace>(_frames_p[i], _idx);
+            if (face_p) {
+                _out_p[i] = *face_p;
+                ++found;
+            }
+        }
+        gathered.fetch_add(found, std::memory_order_relaxed);
+    }, _threads);
+    return gathered.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Extract items of one type from many containers, see Gather(const IData* const*, size_t, TFace*, size_t).
+ * @tparam TFace The data type to extract.
+ * @param _frames The containers.
+ * @param[out] _out Items of the containers (resized to the containers count), default value for missed items.
+ * @param _idx Index of the item in each container.
+ * @param _threads Maximal count of the threads, 0 for std::thread::hardware_concurrency().
+ * @return Count of the extracted items.
+ */
+template <typename TFace>
+size_t Gather(const std::vector<const IData*>& _frames, std::vector<TFace>& _out, size_t _idx = 0, size_t _threads = 0)
+{
+    _out.assign(_frames.size(), TFace {});
+    return Gather(_frames.data(), _frames.size(), _out.data(), _idx, _threads);
+}
+
+/**
+ * @brief Write items of one type into many containers, the opposite of Gather().
+ *
+ * Large inputs are split between threads like for Gather(), so the containers must be distinct.
+ * @tparam TFace The data type to write.
+ * @param _frames_p Array of the containers, may contain null pointers.
+ * @param _count Count of the containers.
+ * @param _values_p Array of _count items to write.
+ * @param _idx Index for the item in each container, -1 for add new one.
+ * @param _threads Maximal count of the threads, 0 for std::thread::hardware_concurrency().
+ * @return Count of the written items.
+ */
+template <typename TFace>
+size_t Scatter(IData* const* _frames_p, size_t _count, const TFace* _values_p, size_t _idx = 0, size_t _threads = 0)
+{
+    std::atomic<size_t> scattered = {0};
+    detail::ParallelFor(_count, detail::kGatherGrain, [&](size_t _begin, size_t _end) {
+        size_t written = 0;
+        for (size_t i = _begin; i < _end; ++i) {
+            auto* concrete_p = detail::AsConcrete(_frames_p[i]);
+            auto  set_idx    = concrete_p ? Set(concrete_p, _idx, _values_p[i]) : Set(_frames_p[i], _idx, _values_p[i]);
+            if (set_idx != size_t(-1))
+                ++written;
+        }
+        scattered.fetch_add(written, std::memory_order_relaxed);
+    }, _threads);
+    return scattered.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Write items of one type into many containers, see Scatter(IData* const*, size_t, const TFace*, size_t).
+ * @tparam TFace The data type to write.
+ * @param _frames The containers.
+ * @param _values Items to write, one per container.
+ * @param _idx Index for the item in each container, -1 for add new one.
+ * @param _threads Maximal count of the threads, 0 for std::thread::hardware_concurrency().
+ * @return Count of the written items.
+ */
+template <typename TFace>
+size_t Scatter(const std::vector<IData*>& _frames,
+               const std::vector<TFace>&  _values,
+               size_t                     _idx     = 0,
+               size_t                     _threads = 0)
+{
+    return Scatter(_frames.data(), std::min(_frames.size(), _values.size()), _values.data(), _idx, _threads);
+}
+
+} // namespace xsdk::xdata
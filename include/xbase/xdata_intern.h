@@ -0,0 +1,116 @@
+#pragma once
+
+#include "xdata.h"
+
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace xsdk::xdata {
+
+namespace detail {
+
+    using InternEqualFn = bool (*)(const void* _stored_p, const void* _value_p);
+    using InternMakeFn  = std::shared_ptr<const void> (*)(void* _value_p, uint64_t _type_uid, size_t _hash);
+
+    /**
+     * @brief Find the canonical instance of the value in the pool, or make and add it if there is no such.
+     * Implemetation in xdata_intern.cpp
+     */
+    std::shared_ptr<const void> Intern(uint64_t      _type_uid,
+                                       size_t        _hash,
+                                       void*         _value_p,
+                                       InternEqualFn _equal,
+                                       InternMakeFn  _make);
+
+    /**
+     * @brief Remove the instance from the pool, called when the last reference to the instance is released.
+     * Implemetation in xdata_intern.cpp
+     */
+    void InternRelease(uint64_t _type_uid, size_t _hash, const void* _stored_p);
+
+    template <typename Face>
+    bool InternEqual(const void* _stored_p, const void* _value_p)
+    {
+        return *static_cast<const Face*>(_stored_p) == *static_cast<const Face*>(_value_p);
+    }
+
+    template <typename Face, typename TFace>
+    std::shared_ptr<const void> InternMake(void* _value_p, uint64_t _type_uid, size_t _hash)
+    {
+        // Not std::make_shared(): the pool holds std::weak_ptr, so the value memory must be freed by the deleter
+        auto* face_p = new Face(std::forward<TFace>(*static_cast<std::remove_reference_t<TFace>*>(_value_p)));
+        return std::shared_ptr<const Face>(face_p, [_type_uid, _hash](const Face* _face_p) {
+            InternRelease(_type_uid, _hash, _face_p);
+            delete _face_p;
+        });
+    }
+
+} // namespace detail
+
+/**
+ * @brief Get the canonical shared instance of the value.
+ *
+ * Values are hash-consed in a global concurrent pool keyed by TypeUid and the value hash: equal values interned
+ * anywhere in the process share one allocation for as long as someone holds them. The pool keeps no strong
+ * references, an instance is removed from the pool when its last reference is released.
+ * Store the result by xdata::SetShared(), so identical metadata of many frames takes no extra allocations and
+ * xdata::Equal() compares it by pointer.
+ * @tparam TFace The data type, must be equality comparable.
+ * @tparam THash Hash function for the data type.
+ * @param _face The value to intern, it is moved into the pool only if there is no equal value.
+ * @return The canonical instance of the value.
+ */
+template <typename TFace, typename THash = std::hash<std::decay_t<TFace>>>
+std::shared_ptr<const std::decay_t<TFace>> Intern(TFace&& _face)
+{
+    using Face = std::decay_t<TFace>;
+
+    auto* value_p = const_cast<void*>(static_cast<const void*>(std::addressof(_face)));
+    return std::static_pointer_cast<const Face>(detail::Intern(xbase::TypeUid<Face>(),
+                                                               THash {}(_face),
+                                                               value_p,
+                                                               &detail::InternEqual<Face>,
+                                                               &detail::InternMake<Face, TFace&&>));
+}
+
+/**
+ * @brief Set a single data item by sharing an existing instance (e.g. returned by xdata::Intern()).
+ * @tparam TFace The data type to set.
+ * @param _xdata_p Pointer to the IData instance.
+ * @param _idx Index for the data to set.
+ * @param _face_p Instance to share, must not be null.
+ * @return Index of the added data if successful, otherwise -1.
+ */
+template <typename TFace>
+size_t SetShared(IData* _xdata_p, size_t _idx, std::shared_ptr<TFace> _face_p)
+{
+    if (!_xdata_p || !_face_p)
+        return -1;
+
+    return _xdata_p->DataSetEntry(xbase::TypeUid<std::remove_cv_t<TFace>>(),
+                                  Entry(Box(std::move(_face_p)), Box()),
+                                  _idx);
+}
+
+/**
+ * @brief Compare items of two containers, the shared (e.g. interned) instances are compared by pointer only.
+ * @tparam TFace The data type to compare, must be equality comparable.
+ * @param _xdata_p First IData instance.
+ * @param _other_p Second IData instance.
+ * @param _idx Index of the items to compare.
+ * @return True if both items are missing or equal, otherwise false.
+ */
+template <typename TFace>
+bool Equal(const IData* _xdata_p, const IData* _other_p, size_t _idx = 0)
+{
+    const auto* face_p  = Peek<TFace>(_xdata_p, _idx);
+    const auto* other_p = Peek<TFace>(_other_p, _idx);
+    if (face_p == other_p)
+        return true;
+
+    return face_p && other_p && *face_p == *other_p;
+}
+
+} // namespace xsdk::xdata
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "xdata_core.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace xsdk::xdata {
+
+/**
+ * @brief Pool of recycled XData containers.
+ *
+ * A released container is cleared with its storage capacity kept (see IData::Clear()) and returned to the pool, so
+ * per-frame containers of the same shape do no container allocations in steady state. Refill an acquired container
+ * by IData::CloneInto() instead of IData::Clone() for the same effect.
+ * The pool is thread safe, the acquired containers may outlive the pool (then they are just deleted on release, the
+ * released containers kept for reuse are deleted with the pool).
+ */
+class Pool {
+    struct State {
+        std::mutex               mtx;
+        std::vector<XData::UPtr> free;
+        size_t                   max_free = 0;
+    };
+
+public:
+    /**
+     * @brief Deleter of the acquired containers, returns them to the pool if it still exists.
+     */
+    struct Recycler {
+        std::weak_ptr<State> state_wp;
+
+        void operator()(XData* _xdata_p) const noexcept; // Implemetation in xdata_pool.cpp
+    };
+
+    using Ptr = std::unique_ptr<XData, Recycler>;
+
+    /**
+     * @brief Creates a pool.
+     * @param _max_free Maximum count of the released containers kept for reuse.
+     */
+    explicit Pool(size_t _max_free = 64);
+
+    /**
+     * @brief Get a recycled (empty) container or create a new one if the pool is empty.
+     * @return Container returned to the pool on release.
+     */
+    Ptr Acquire();
+
+    /**
+     * @brief Get count of the released containers kept for reuse.
+     */
+    size_t FreeCount() const;
+
+private:
+    std::shared_ptr<State> state_p_;
+};
+
+} // namespace xsdk::xdata
@@ -0,0 +1,364 @@
+#pragma once
+
+#include "xdata.h"
+#include "xdata_core.h"
+#include "xdata_slot.h"
+
+#include <array>
+#include <map>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace xsdk::xdata {
+
+namespace detail {
+
+    template <typename T, typename... TFields>
+    constexpr size_t IndexOf()
+    {
+        constexpr std::array<bool, sizeof...(TFields)> matches {std::is_same_v<T, TFields>...};
+        for (size_t i = 0; i < matches.size(); ++i) {
+            if (matches[i])
+                return i;
+        }
+        return sizeof...(TFields);
+    }
+
+    template <typename... TFields>
+    constexpr bool AllUnique()
+    {
+        constexpr std::array<xbase::Uid, sizeof...(TFields)> uids {xbase::TypeUid<TFields>()...};
+        for (size_t i = 0; i < uids.size(); ++i) {
+            for (size_t j = i + 1; j < uids.size(); ++j) {
+                if (uids[i] == uids[j])
+                    return false;
+            }
+        }
+        return true;
+    }
+
+} // namespace detail
+
+/**
+ * @brief IData with a static schema.
+ *
+ * Each declared type has its entries slot at a fixed offset inside the object, so the typed accessors (and the xdata::
+ * helpers taking Record pointer, see xdata_core.h) find the entries without hashing, map lookups or virtual calls.
+ * The values themselves are not stored inline: like in any IData, each entry is a shared Box (the value is allocated
+ * by xdata::Set() and a read checks the boxed TypeUid and goes through the heap pointer), so entries can be shared
+ * with clones, snapshots and legacy API users. Entries of any other UID go to the dynamic overflow map, so Record is
+ * a drop-in replacement for the IData created by xdata::Create().
+ * @tparam TFields The declared (unnamed) data types, each type can be declared only once.
+ */
+template <typename... TFields>
+class Record final: public IData {
+    static_assert(sizeof...(TFields) > 0, "Record requires at least one field");
+    static_assert(detail::AllUnique<TFields...>(), "Record fields must be unique");
+    static_assert((std::is_same_v<TFields, std::decay_t<TFields>> && ...), "Record fields must be decayed types");
+
+    static constexpr std::array<xbase::Uid, sizeof...(TFields)> kFieldUids {xbase::TypeUid<TFields>()...};
+
+public:
+    USING_PTRS(Record)
+
+    /**
+     * @brief Check if the type is a declared field of the record.
+     */
+    template <typename TFace>
+    static constexpr bool kHasField = detail::IndexOf<std::decay_t<TFace>, TFields...>() < sizeof...(TFields);
+
+    Record() = default;
+
+    //-------------------------------------------------------------------------------
+    // Typed accessors
+
+    /**
+     * @brief Get count of elements of the same type.
+     * @tparam TFace The data type to get the count for.
+     * @return Data count.
+     */
+    template <typename TFace>
+    size_t Count() const noexcept
+    {
+        if constexpr (kHasField<TFace>)
+            return Field<TFace>().Size();
+        else
+            return DataCount(xbase::TypeUid<std::decay_t<TFace>>());
+    }
+
+    /**
+     * @brief Get an entry by its type.
+     * @tparam TFace The data type of the entry.
+     * @param _idx Index of the entry.
+     * @return Pointer to the entry valid until the record is modified, or nullptr if there is no such entry.
+     */
+    template <typename TFace>
+    const Entry* EntryAt(size_t _idx = 0) const noexcept
+    {
+        if constexpr (kHasField<TFace>)
+            return budget_.Touch(xbase::TypeUid<std::decay_t<TFace>>(), Field<TFace>().At(_idx));
+        else
+            return DataGetEntry(xbase::TypeUid<std::decay_t<TFace>>(), _idx);
+    }
+
+    /**
+     * @brief Get a raw pointer to an item by index and its type, without touching the reference counter.
+     * @tparam TFace The data type to get.
+     * @param _idx Index for the data to get.
+     * @return Pointer valid until the record is modified, or a null pointer if there is no such item.
+     */
+    template <typename TFace>
+    const TFace* Peek(size_t _idx = 0) const
+    {
+        const Entry* entry_p = EntryAt<TFace>(_idx);
+        return entry_p ? entry_p->face.template Peek<TFace>() : nullptr;
+    }
+
+    /**
+     * @brief Set an item by its type.
+     * @tparam TFace The data type to set.
+     * @param _idx Index for the data to set, -1 for add new one.
+     * @param _entry Entry to set.
+     * @return Index of the set item.
+     */
+    template <typename TFace>
+    size_t SetEntry(size_t _idx, Entry&& _entry)
+    {
+        constexpr auto kUid = xbase::TypeUid<std::decay_t<TFace>>();
+        if constexpr (kHasField<TFace>)
+            return budget_.Store(Field<TFace>(), _idx, std::move(_entry), SlotsVisitor());
+        else
+            return budget_.Store(overflow_[kUid], _idx, std::move(_entry), SlotsVisitor());
+    }
+
+    //-------------------------------------------------------------------------------
+    // IData
+
+    using IData::Clone;
+    using IData::CloneInto;
+    using IData::Fingerprint;
+
+    IData::UPtr Clone(const TypeFilter& _filter) const override
+    {
+        auto cloned_p = std::make_unique<Record>();
+        cloned_p->budget_.SettingsCopy(budget_);
+        CloneInto(*cloned_p, _filter);
+        return cloned_p;
+    }
+
+    void CloneInto(IData& _dst, const TypeFilter& _filter) const override
+    {
+        auto is_cloned = [&](uint64_t _uid) { return _filter.Match(_uid); };
+
+        if (&_dst == this) {
+            auto& self = static_cast<Record&>(_dst);
+            self.SlotsForEach([&](uint64_t _uid, detail::EntrySlot& _slot) {
+                if (_slot.Size() && !is_cloned(_uid))
+                    self.budget_.Reset(_slot);
+            });
+            return;
+        }
+
+        auto* record_p = dynamic_cast<Record*>(&_dst);
+        if (!record_p) {
+            _dst.Clear();
+            SlotsForEach([&](uint64_t _uid, const detail::EntrySlot& _slot) {
+                if (_slot.Size() && is_cloned(_uid))
+                    detail::SlotCopyTo(_dst, _uid, _slot);
+            });
+            return;
+        }
+
+        // Same record type: copy the slots over the existing ones, so their storage is reused
+        record_p->Clear();
+        for (size_t i = 0; i < fields_.size(); ++i) {
+            if (fields_[i].Size() && is_cloned(kFieldUids[i])) {
+                record_p->fields_[i] = fields_[i];
+                record_p->budget_.Add(fields_[i]);
+            }
+        }
+        for (const auto& [uid, slot] : overflow_) {
+            if (slot.Size() && is_cloned(uid)) {
+                record_p->overflow_[uid] = slot;
+                record_p->budget_.Add(slot);
+            }
+        }
+
+        // The destination keeps its own budget, which may be smaller than the source usage
+        record_p->budget_.Fit(record_p->SlotsVisitor());
+    }
+
+    void Clear() override
+    {
+        for (auto& field : fields_)
+            field.Reset();
+
+        // Overflow slots unused since the previous Clear() are dropped, so the map doesn't grow with every UID ever set
+        for (auto it = overflow_.begin(); it != overflow_.end();) {
+            if (it->second.Reset())
+                ++it;
+            else
+                it = overflow_.erase(it);
+        }
+        budget_.Clear();
+    }
+
+    IData::SPtrC Freeze() const override
+    {
+        std::vector<std::pair<uint64_t, const detail::EntrySlot*>> slots;
+        slots.reserve(fields_.size() + overflow_.size());
+        SlotsForEach([&](uint64_t _uid, const detail::EntrySlot& _slot) { slots.emplace_back(_uid, &_slot); });
+
+        return detail::FreezeSlots(std::move(slots));
+    }
+
+    size_t DataSetEntry(uint64_t _data_uid, Entry&& _entry, size_t _idx) override
+    {
+        if (auto* field_p = FieldByUid(_data_uid))
+            return budget_.Store(*field_p, _idx, std::move(_entry), SlotsVisitor());
+        return budget_.Store(overflow_[_data_uid], _idx, std::move(_entry), SlotsVisitor());
+    }
+
+    size_t DataCount(uint64_t _data_uid) const override
+    {
+        const auto* slot_p = SlotByUid(_data_uid);
+        return slot_p ? slot_p->Size() : 0;
+    }
+
+    const Entry* DataGetEntry(uint64_t _data_uid, size_t _idx) const override
+    {
+        const auto* slot_p = SlotByUid(_data_uid);
+        return slot_p ? budget_.Touch(_data_uid, slot_p->At(_idx)) : nullptr;
+    }
+
+    Entry DataRemoveEntry(uint64_t _data_uid, size_t _idx) override
+    {
+        if (auto* field_p = FieldByUid(_data_uid))
+            return budget_.Take(*field_p, _idx);
+
+        auto it = overflow_.find(_data_uid);
+        if (it == overflow_.end())
+            return {};
+
+        auto removed = budget_.Take(it->second, _idx);
+        if (!it->second.Size())
+            overflow_.erase(it);
+
+        return removed;
+    }
+
+    bool DataReset(uint64_t _data_uid) override
+    {
+        if (auto* field_p = FieldByUid(_data_uid))
+            return budget_.Reset(*field_p);
+
+        auto it = overflow_.find(_data_uid);
+        if (it == overflow_.end())
+            return false;
+
+        // Slot may be empty after Clear()
+        auto reset = budget_.Reset(it->second);
+        overflow_.erase(it);
+        return reset;
+    }
+
+    size_t DataMemoryUsage() const override { return budget_.Usage(); }
+
+    void DataBudgetSet(size_t _max_bytes, EvictPolicy _policy) override { budget_.Set(_max_bytes, _policy); }
+
+    void DataBudgetPolicySet(uint64_t _data_uid, EvictPolicy _policy) override
+    {
+        budget_.PolicySet(_data_uid, _policy);
+    }
+
+    uint64_t Fingerprint(const TypeFilter& _filter) const override
+    {
+        return fingerprint_.Get(budget_.Revision(), _filter.Key(), [&] {
+            uint64_t fingerprint = 0;
+            for (size_t i = 0; i < fields_.size(); ++i) {
+                if (fields_[i].Size() && _filter.Match(kFieldUids[i]))
+                    fingerprint += detail::SlotHash(kFieldUids[i], fields_[i]);
+            }
+            for (const auto& [uid, slot] : overflow_) {
+                if (slot.Size() && _filter.Match(uid))
+                    fingerprint += detail::SlotHash(uid, slot);
+            }
+            return fingerprint;
+        });
+    }
+
+private:
+    auto SlotsVisitor()
+    {
+        return [this](auto&& _func) { SlotsForEach(_func); };
+    }
+
+    template <typename TFunc>
+    void SlotsForEach(TFunc&& _func)
+    {
+        for (size_t i = 0; i < fields_.size(); ++i)
+            _func(kFieldUids[i], fields_[i]);
+        for (auto& [uid, slot] : overflow_)
+            _func(uid, slot);
+    }
+
+    template <typename TFunc>
+    void SlotsForEach(TFunc&& _func) const
+    {
+        for (size_t i = 0; i < fields_.size(); ++i)
+            _func(kFieldUids[i], fields_[i]);
+        for (const auto& [uid, slot] : overflow_)
+            _func(uid, slot);
+    }
+
+    template <typename TFace>
+    const detail::EntrySlot& Field() const noexcept
+    {
+        return fields_[detail::IndexOf<std::decay_t<TFace>, TFields...>()];
+    }
+
+    template <typename TFace>
+    detail::EntrySlot& Field() noexcept
+    {
+        return fields_[detail::IndexOf<std::decay_t<TFace>, TFields...>()];
+    }
+
+    const detail::EntrySlot* FieldByUid(uint64_t _data_uid) const noexcept
+    {
+        for (size_t i = 0; i < kFieldUids.size(); ++i) {
+            if (kFieldUids[i] == _data_uid)
+                return &fields_[i];
+        }
+        return nullptr;
+    }
+
+    detail::EntrySlot* FieldByUid(uint64_t _data_uid) noexcept
+    {
+        return const_cast<detail::EntrySlot*>(std::as_const(*this).FieldByUid(_data_uid));
+    }
+
+    const detail::EntrySlot* SlotByUid(uint64_t _data_uid) const noexcept
+    {
+        if (const auto* field_p = FieldByUid(_data_uid))
+            return field_p;
+
+        auto it = overflow_.find(_data_uid);
+        return it == overflow_.end() ? nullptr : &it->second;
+    }
+
+private:
+    std::array<detail::EntrySlot, sizeof...(TFields)> fields_;
+    std::map<uint64_t, detail::EntrySlot>              overflow_; // May contain empty slots kept by the last Clear()
+    detail::MemoryBudget                               budget_;
+    detail::FingerprintCache                           fingerprint_;
+};
+
+namespace detail {
+
+    template <typename... TFields>
+    struct IsConcrete<Record<TFields...>>: std::true_type {};
+
+} // namespace detail
+
+} // namespace xsdk::xdata
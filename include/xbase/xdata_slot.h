@@ -0,0 +1,378 @@
+#pragma once
+
+#include "xdata.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace xsdk::xdata::detail {
+
+/**
+ * @brief Entries of a single UID: the first entry is stored inline, the rest in a vector.
+ */
+class EntrySlot {
+public:
+    size_t Size() const noexcept { return size_; }
+
+    const Entry* At(size_t _idx) const noexcept
+    {
+        if (_idx >= size_)
+            return nullptr;
+        return _idx == 0 ? &head_ : &tail_[_idx - 1];
+    }
+
+    Entry* At(size_t _idx) noexcept { return const_cast<Entry*>(std::as_const(*this).At(_idx)); }
+
+    size_t Set(size_t _idx, Entry&& _entry)
+    {
+        if (_idx >= size_) {
+            if (size_ == 0)
+                head_ = std::move(_entry);
+            else
+                tail_.emplace_back(std::move(_entry));
+            return size_++;
+        }
+        *At(_idx) = std::move(_entry);
+        return _idx;
+    }
+
+    Entry Remove(size_t _idx)
+    {
+        if (_idx >= size_)
+            return {};
+
+        Entry removed;
+        if (_idx == 0) {
+            removed = std::move(head_);
+            if (!tail_.empty()) {
+                head_ = std::move(tail_.front());
+                tail_.erase(tail_.begin());
+            }
+        }
+        else {
+            removed = std::move(tail_[_idx - 1]);
+            tail_.erase(tail_.begin() + (_idx - 1));
+        }
+        --size_;
+        return removed;
+    }
+
+    bool Reset()
+    {
+        if (!size_)
+            return false;
+
+        head_ = {};
+        tail_.clear();
+        size_ = 0;
+        return true;
+    }
+
+    size_t Bytes() const noexcept
+    {
+        size_t bytes = 0;
+        for (size_t i = 0; i < size_; ++i)
+            bytes += At(i)->bytes;
+        return bytes;
+    }
+
+private:
+    size_t             size_ = 0;
+    Entry              head_;
+    std::vector<Entry> tail_;
+};
+
+/**
+ * @brief Memory accounting and budget eviction shared by the IData implementations.
+ */
+class MemoryBudget {
+public:
+    MemoryBudget()                               = default;
+    MemoryBudget(const MemoryBudget&)            = delete;
+    MemoryBudget& operator=(const MemoryBudget&) = delete;
+
+    size_t Usage() const noexcept { return usage_; }
+
+    // Every container modification goes through the budget, so it also counts the container revisions
+    uint64_t Revision() const noexcept { return revision_; }
+
+    void Set(size_t _max_bytes, IData::EvictPolicy _policy) noexcept
+    {
+        max_bytes_ = _max_bytes;
+        policy_    = _policy;
+    }
+
+    void PolicySet(uint64_t _data_uid, IData::EvictPolicy _policy) { policies_[_data_uid] = _policy; }
+
+    IData::EvictPolicy PolicyOf(uint64_t _data_uid) const noexcept
+    {
+        if (policies_.empty())
+            return policy_;
+
+        auto it = policies_.find(_data_uid);
+        return it == policies_.end() ? policy_ : it->second;
+    }
+
+    // Copies the budget settings (not the usage) for cloned container
+    void SettingsCopy(const MemoryBudget& _other)
+    {
+        Set(_other.max_bytes_, _other.policy_);
+        policies_ = _other.policies_;
+    }
+
+    // Removes the budget and the per-UID policies
+    void SettingsReset() noexcept
+    {
+        Set(0, IData::EvictPolicy::OldestFirst);
+        policies_.clear();
+    }
+
+    /**
+     * @brief Stores the entry into the slot, evicts entries of the container if the budget is exceeded.
+     * @param _slot Slot of the entry UID.
+     * @param _idx Index for the entry to set.
+     * @param _entry The entry to store.
+     * @param _slots_for_each Callable visiting all the container slots: _slots_for_each(func(uid, EntrySlot&)).
+     * @return Index of the stored entry or -1 if the entry doesn't fit into the budget (then nothing is changed).
+     */
+    template <typename TSlotsForEach>
+    size_t Store(EntrySlot& _slot, size_t _idx, Entry&& _entry, TSlotsForEach&& _slots_for_each)
+    {
+        _entry.bytes = SizeEstimate(_entry.face) + SizeEstimate(_entry.holder);
+
+        const auto* prev_p     = _slot.At(_idx);
+        size_t      prev_bytes = prev_p ? prev_p->bytes : 0;
+        size_t      new_usage  = usage_ - prev_bytes + _entry.bytes;
+        if (max_bytes_ && new_usage > max_bytes_) {
+            // The replaced entry (if any) is excluded from the candidates as it's released anyway
+            size_t evictable = 0;
+            _slots_for_each([&](uint64_t _uid, const EntrySlot& _other) {
+                for (size_t i = 0; i < _other.Size(); ++i) {
+                    if ((&_other != &_slot || i != _idx) && IsEvictable(_uid, *_other.At(i)))
+                        evictable += _other.At(i)->bytes;
+                }
+            });
+            if (new_usage - evictable > max_bytes_)
+                return -1;
+        }
+
+        _entry.tick.store(NextTick(), std::memory_order_relaxed);
+        usage_ = new_usage;
+        _idx   = _slot.Set(_idx, std::move(_entry));
+        ++revision_;
+
+        Evict(&_slot, _idx, _slots_for_each);
+        return _idx;
+    }
+
+    /**
+     * @brief Brings the usage within the budget after slots were copied in by Add(), like Store() does for one entry.
+     * Evicts the evictable entries by the policy, then removes the newest not evictable ones (Store() would reject
+     * them).
+     * @param _slots_for_each Callable visiting all the container slots: _slots_for_each(func(uid, EntrySlot&)).
+     */
+    template <typename TSlotsForEach>
+    void Fit(TSlotsForEach&& _slots_for_each)
+    {
+        size_t no_idx = -1;
+        Evict(nullptr, no_idx, _slots_for_each);
+
+        while (max_bytes_ && usage_ > max_bytes_) {
+            EntrySlot* newest_slot_p = nullptr;
+            size_t     newest_idx    = 0;
+            uint64_t   newest_tick   = 0;
+            _slots_for_each([&](uint64_t, EntrySlot& _other) {
+                for (size_t i = 0; i < _other.Size(); ++i) {
+                    auto tick = _other.At(i)->tick.load(std::memory_order_relaxed);
+                    if (_other.At(i)->bytes && (!newest_slot_p || tick >= newest_tick)) {
+                        newest_slot_p = &_other;
+                        newest_idx    = i;
+                        newest_tick   = tick;
+                    }
+                }
+            });
+            if (!newest_slot_p)
+                break;
+
+            Take(*newest_slot_p, newest_idx);
+        }
+    }
+
+    Entry Take(EntrySlot& _slot, size_t _idx)
+    {
+        auto removed = _slot.Remove(_idx);
+        usage_ -= removed.bytes;
+        ++revision_;
+        return removed;
+    }
+
+    bool Reset(EntrySlot& _slot)
+    {
+        usage_ -= _slot.Bytes();
+        ++revision_;
+        return _slot.Reset();
+    }
+
+    // Accounts reset of all the container slots
+    void Clear() noexcept
+    {
+        usage_ = 0;
+        ++revision_;
+    }
+
+    // Accounts a slot copied from other container, the copied entries keep their ticks, so the tick counter is moved
+    // past them for rank the entries set after the copy as newer
+    void Add(const EntrySlot& _slot) noexcept
+    {
+        usage_ += _slot.Bytes();
+        ++revision_;
+
+        auto tick = tick_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < _slot.Size(); ++i)
+            tick = std::max(tick, _slot.At(i)->tick.load(std::memory_order_relaxed));
+        tick_.store(tick, std::memory_order_relaxed);
+    }
+
+    // Marks the entry as used for EvictPolicy::Lru
+    const Entry* Touch(uint64_t _data_uid, const Entry* _entry_p) const noexcept
+    {
+        if (_entry_p && max_bytes_ && PolicyOf(_data_uid) == IData::EvictPolicy::Lru)
+            _entry_p->tick.store(NextTick(), std::memory_order_relaxed);
+        return _entry_p;
+    }
+
+private:
+    // Evicts the oldest evictable entries while the budget is exceeded, the kept entry is never evicted and its index
+    // is adjusted for removals from the same slot
+    template <typename TSlotsForEach>
+    void Evict(const EntrySlot* _keep_slot_p, size_t& _keep_idx, TSlotsForEach& _slots_for_each)
+    {
+        while (max_bytes_ && usage_ > max_bytes_) {
+            EntrySlot* victim_slot_p = nullptr;
+            size_t     victim_idx    = 0;
+            uint64_t   victim_tick   = std::numeric_limits<uint64_t>::max();
+            _slots_for_each([&](uint64_t _uid, EntrySlot& _other) {
+                for (size_t i = 0; i < _other.Size(); ++i) {
+                    auto tick = _other.At(i)->tick.load(std::memory_order_relaxed);
+                    if ((&_other != _keep_slot_p || i != _keep_idx) && tick < victim_tick &&
+                        IsEvictable(_uid, *_other.At(i))) {
+                        victim_slot_p = &_other;
+                        victim_idx    = i;
+                        victim_tick   = tick;
+                    }
+                }
+            });
+            if (!victim_slot_p)
+                break;
+
+            Take(*victim_slot_p, victim_idx);
+            if (victim_slot_p == _keep_slot_p && victim_idx < _keep_idx)
+                --_keep_idx;
+        }
+    }
+
+    uint64_t NextTick() const noexcept { return tick_.fetch_add(1, std::memory_order_relaxed) + 1; }
+
+    // Lazy entries are not accounted (see SizeEstimate()), so evicting them can't reduce the usage
+    bool IsEvictable(uint64_t _data_uid, const Entry& _entry) const noexcept
+    {
+        return !_entry.face.IsLazy() && PolicyOf(_data_uid) != IData::EvictPolicy::Never;
+    }
+
+private:
+    size_t                                 max_bytes_ = 0;
+    IData::EvictPolicy                     policy_    = IData::EvictPolicy::OldestFirst;
+    std::map<uint64_t, IData::EvictPolicy> policies_;
+    size_t                                 usage_    = 0;
+    uint64_t                               revision_ = 0;
+    mutable std::atomic<uint64_t>          tick_     = {0};
+};
+
+/**
+ * @brief Append copies of the slot entries to a container of any implementation.
+ */
+inline void SlotCopyTo(IData& _dst, uint64_t _data_uid, const EntrySlot& _slot)
+{
+    for (size_t i = 0; i < _slot.Size(); ++i)
+        _dst.DataSetEntry(_data_uid, Entry(*_slot.At(i)), -1);
+}
+
+/**
+ * @brief Hash of the entries of a single UID, entries hashes are cached in the entries.
+ *
+ * Slot hashes are well mixed, so the container fingerprint is their sum and doesn't depend on the slots order.
+ * Entries without hash (HashCompute() returns 0) are skipped, a slot without hashed entries gives 0.
+ * @param _data_uid The entries UID.
+ * @param _count Count of the entries.
+ * @param _entry_at Callable returning pointer to the entry by its index.
+ */
+template <typename TEntryAt>
+uint64_t SlotHash(uint64_t _data_uid, size_t _count, TEntryAt&& _entry_at)
+{
+    uint64_t hash   = _data_uid;
+    size_t   hashed = 0;
+    for (size_t i = 0; i < _count; ++i) {
+        const Entry* entry_p    = _entry_at(i);
+        auto         entry_hash = entry_p->face_hash.load(std::memory_order_relaxed);
+        if (!entry_hash) {
+            entry_hash = HashCompute(entry_p->face);
+            entry_p->face_hash.store(entry_hash, std::memory_order_relaxed);
+        }
+        if (entry_hash) {
+            hash = xbase::HashCombine(hash, entry_hash);
+            ++hashed;
+        }
+    }
+    if (!hashed)
+        return 0;
+
+    // splitmix64 finalizer
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111eb;
+    return hash ^ (hash >> 31);
+}
+
+inline uint64_t SlotHash(uint64_t _data_uid, const EntrySlot& _slot)
+{
+    return SlotHash(_data_uid, _slot.Size(), [&](size_t _idx) { return _slot.At(_idx); });
+}
+
+/**
+ * @brief Make an immutable snapshot (see IData::Freeze()) of the slots, the empty slots are skipped.
+ * Implemetation in xdata_frozen.cpp
+ */
+IData::SPtrC FreezeSlots(std::vector<std::pair<uint64_t, const EntrySlot*>> _slots);
+
+/**
+ * @brief Container fingerprint cache, valid while the container revision and the filter are the same.
+ */
+class FingerprintCache {
+public:
+    template <typename TCompute>
+    uint64_t Get(uint64_t _revision, uint64_t _filter_key, TCompute&& _compute) const
+    {
+        std::lock_guard lck(mtx_);
+
+        if (!valid_ || revision_ != _revision || filter_key_ != _filter_key) {
+            value_      = _compute();
+            revision_   = _revision;
+            filter_key_ = _filter_key;
+            valid_      = true;
+        }
+        return value_;
+    }
+
+private:
+    mutable std::mutex mtx_;
+    mutable bool       valid_      = false;
+    mutable uint64_t   revision_   = 0;
+    mutable uint64_t   filter_key_ = 0;
+    mutable uint64_t   value_      = 0;
+};
+
+} // namespace xsdk::xdata::detail
@@ -6,6 +6,8 @@
 #include <any>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace xsdk {
 
@@ -87,5 +89,88 @@ namespace xobject {
         return obj_spp ? *obj_spp : nullptr;
     }
 
+    /**
+     * @brief Registration of an object in the global object registry.
+     *
+     * The registration removes the object from the registry when destroyed, so an object keeping its registration as a
+     * member is deregistered automatically on destruction. The registry holds only weak references, so xobject::Find()
+     * never returns a destroyed object even before the registration is destroyed.
+     */
+    class Registration {
+    public:
+        Registration() = default;
+        Registration(uint64_t _object_uid, uint64_t _serial) : object_uid_(_object_uid), serial_(_serial) {}
+        ~Registration() { Reset(); }
+
+        Registration(const Registration&)            = delete;
+        Registration& operator=(const Registration&) = delete;
+        Registration(Registration&& _other) noexcept
+            : object_uid_(_other.object_uid_),
+              serial_(std::exchange(_other.serial_, 0))
+        {
+        }
+        Registration& operator=(Registration&& _other) noexcept
+        {
+            if (this != &_other) {
+                Reset();
+                object_uid_ = _other.object_uid_;
+                serial_     = std::exchange(_other.serial_, 0);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Returns the UID of the registered object, or 0 if empty.
+         */
+        uint64_t ObjectUid() const noexcept { return serial_ ? object_uid_ : 0; }
+
+        /**
+         * @brief Remove the object from the registry (if it's still registered by this registration).
+         */
+        void Reset() noexcept; // Implemetation in xobject_registry.cpp
+
+    private:
+        uint64_t object_uid_ = 0;
+        uint64_t serial_     = 0;
+    };
+
+    /**
+     * @brief Register an object in the global object registry by its ObjectUid().
+     *
+     * The registry is a striped concurrent hash map, so registrations and lookups of different objects rarely contend.
+     * Registering an object with the same UID again replaces the previous registration.
+     * @param _obj_sp The object to register.
+     * @return Registration which removes the object from the registry when destroyed, empty if _obj_sp is null.
+     */
+    [[nodiscard]] Registration Register(const IObject::SPtr& _obj_sp);
+
+    /**
+     * @brief Find a registered object by its UID.
+     * @param _object_uid The object UID.
+     * @return Shared pointer to the object or nullptr if it's not registered or already destroyed.
+     */
+    IObject::SPtr Find(uint64_t _object_uid);
+
+    /**
+     * @brief Find a registered object by its UID and query a pointer of a given type from it.
+     * @tparam TObject The type of the object to query.
+     * @param _object_uid The object UID.
+     * @return Shared pointer to the object or nullptr if it's not found or doesn't support the type.
+     */
+    template <typename TObject>
+    std::shared_ptr<TObject> Find(uint64_t _object_uid)
+    {
+        auto obj_sp = Find(_object_uid);
+        return PtrQuery<TObject>(obj_sp.get());
+    }
+
+    /**
+     * @brief Get all alive registered objects.
+     * The registry is scanned stripe by stripe and each stripe is locked only for copy its weak references, so the
+     * snapshot does not block registrations of other stripes and does not keep objects alive while scanning.
+     * @return Objects alive at the moment of the scan of their stripe.
+     */
+    std::vector<IObject::SPtr> Snapshot();
+
 } // namespace xobject
 } // namespace xsdk
\ No newline at end of file
@@ -38,6 +38,20 @@ constexpr uint64_t HashString(std::string_view _to_hash)
     return result;
 }
 
+/**
+ * @brief Combine two hash values into one.
+ * This function mixes the second value into the first one, the result depends on the order of arguments.
+ * @param _seed The hash value to combine with.
+ * @param _value The hash value to be combined.
+ * @return The combined hash value, can be used as a compile-time constant.
+ */
+constexpr uint64_t HashCombine(uint64_t _seed, uint64_t _value)
+{
+    // 64 bit variant of boost::hash_combine
+    _seed ^= _value + 0x9e3779b97f4a7c15 + (_seed << 12) + (_seed >> 4);
+    return _seed;
+}
+
 /**
  * @brief Obtain a compile-time constant UID for a given C++ type.
  * This template function computes the UID for a given C++ type `T` using the FNV-1a 64-bit algorithm and returns it as
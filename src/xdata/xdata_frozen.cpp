@@ -0,0 +1,216 @@
+#include "xbase/xdata_core.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+namespace xsdk::xdata::detail {
+
+namespace {
+
+    constexpr size_t AlignUp(size_t _offset, size_t _align) noexcept
+    {
+        return (_offset + _align - 1) / _align * _align;
+    }
+
+    // Immutable IData, placed at the start of a raw block followed by the index and the entries (see Create())
+    class FrozenData final: public IData, public std::enable_shared_from_this<FrozenData> {
+        struct IndexItem {
+            uint64_t data_uid;
+            uint32_t first;
+            uint32_t count;
+        };
+
+        // Offsets of the block parts, the object itself is at the block start
+        struct Layout {
+            size_t index_offset;
+            size_t entries_offset;
+            size_t total;
+        };
+
+    public:
+        using Slots = std::vector<std::pair<uint64_t, const EntrySlot*>>;
+
+        // The slots are sorted and not empty
+        static IData::SPtrC Create(const Slots& _slots)
+        {
+            static_assert(alignof(FrozenData) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__ &&
+                              alignof(Entry) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                          "Block parts must be aligned by the default operator new");
+
+            size_t entries = 0;
+            for (const auto& [uid, slot_p] : _slots)
+                entries += slot_p->Size();
+
+            Layout layout {};
+            layout.index_offset   = AlignUp(sizeof(FrozenData), alignof(IndexItem));
+            layout.entries_offset = AlignUp(layout.index_offset + _slots.size() * sizeof(IndexItem), alignof(Entry));
+            layout.total          = layout.entries_offset + entries * sizeof(Entry);
+
+            auto*       block_p  = static_cast<std::byte*>(::operator new(layout.total));
+            FrozenData* frozen_p = nullptr;
+            try {
+                frozen_p = new (block_p) FrozenData(block_p, layout, _slots);
+            }
+            catch (...) {
+                ::operator delete(block_p);
+                throw;
+            }
+
+            // The deleter is called by the constructor if the control block allocation fails
+            return std::shared_ptr<const FrozenData>(frozen_p, [](const FrozenData* _frozen_p) {
+                _frozen_p->~FrozenData();
+                ::operator delete(const_cast<FrozenData*>(_frozen_p));
+            });
+        }
+
+        FrozenData(std::byte* _block_p, const Layout& _layout, const Slots& _slots)
+            : index_p_(reinterpret_cast<IndexItem*>(_block_p + _layout.index_offset)),
+              index_size_(_slots.size()),
+              entries_p_(reinterpret_cast<Entry*>(_block_p + _layout.entries_offset))
+        {
+            // entries_size_ counts the constructed entries, so a failed construction destroys only them
+            try {
+                for (size_t i = 0; i < _slots.size(); ++i) {
+                    const auto& [uid, slot_p] = _slots[i];
+                    new (index_p_ + i)
+                        IndexItem {uid, static_cast<uint32_t>(entries_size_), static_cast<uint32_t>(slot_p->Size())};
+                    for (size_t j = 0; j < slot_p->Size(); ++j) {
+                        const auto* entry_p = new (entries_p_ + entries_size_) Entry(*slot_p->At(j));
+                        ++entries_size_;
+                        usage_ += entry_p->bytes;
+                    }
+                }
+            }
+            catch (...) {
+                DestroyEntries();
+                throw;
+            }
+        }
+
+        ~FrozenData() override { DestroyEntries(); }
+
+        FrozenData(const FrozenData&)            = delete;
+        FrozenData& operator=(const FrozenData&) = delete;
+
+        IData::UPtr Clone(const TypeFilter& _filter) const override
+        {
+            auto cloned_p = XData::Create();
+            CloneInto(*cloned_p, _filter);
+            return cloned_p;
+        }
+
+        void CloneInto(IData& _dst, const TypeFilter& _filter) const override
+        {
+            if (&_dst == this)
+                return;
+
+            _dst.Clear();
+            for (size_t i = 0; i < index_size_; ++i) {
+                const auto& item = index_p_[i];
+                if (!_filter.Match(item.data_uid))
+                    continue;
+
+                for (size_t j = 0; j < item.count; ++j)
+                    _dst.DataSetEntry(item.data_uid, Entry(entries_p_[item.first + j]), -1);
+            }
+        }
+
+        void Clear() override {}
+
+        IData::SPtrC Freeze() const override { return shared_from_this(); }
+
+        size_t DataMemoryUsage() const override { return usage_; }
+        void   DataBudgetSet(size_t, EvictPolicy) override {}
+        void   DataBudgetPolicySet(uint64_t, EvictPolicy) override {}
+
+        uint64_t Fingerprint(const TypeFilter& _filter) const override
+        {
+            if (!_filter.All())
+                return FingerprintCompute(_filter);
+
+            // Immutable, so the full fingerprint is computed once (on demand, for not compute lazy values by Freeze()),
+            // concurrent first callers may compute it twice with the same result
+            if (fingerprint_ready_.load(std::memory_order_acquire))
+                return fingerprint_.load(std::memory_order_relaxed);
+
+            auto fingerprint = FingerprintCompute(_filter);
+            fingerprint_.store(fingerprint, std::memory_order_relaxed);
+            fingerprint_ready_.store(true, std::memory_order_release);
+            return fingerprint;
+        }
+
+        size_t DataSetEntry(uint64_t, Entry&&, size_t) override { return -1; }
+
+        size_t DataCount(uint64_t _data_uid) const override
+        {
+            const auto* item_p = Find(_data_uid);
+            return item_p ? item_p->count : 0;
+        }
+
+        const Entry* DataGetEntry(uint64_t _data_uid, size_t _idx) const override
+        {
+            const auto* item_p = Find(_data_uid);
+            if (!item_p || _idx >= item_p->count)
+                return nullptr;
+
+            return &entries_p_[item_p->first + _idx];
+        }
+
+        Entry DataRemoveEntry(uint64_t, size_t) override { return {}; }
+        bool  DataReset(uint64_t) override { return false; }
+
+    private:
+        void DestroyEntries() noexcept
+        {
+            for (size_t i = 0; i < entries_size_; ++i)
+                entries_p_[i].~Entry();
+        }
+
+        uint64_t FingerprintCompute(const TypeFilter& _filter) const
+        {
+            uint64_t fingerprint = 0;
+            for (size_t i = 0; i < index_size_; ++i) {
+                const auto& item = index_p_[i];
+                if (_filter.Match(item.data_uid)) {
+                    fingerprint += SlotHash(item.data_uid, item.count, [&](size_t _idx) {
+                        return &entries_p_[item.first + _idx];
+                    });
+                }
+            }
+            return fingerprint;
+        }
+
+        const IndexItem* Find(uint64_t _data_uid) const noexcept
+        {
+            auto less = [](const IndexItem& _item, uint64_t _uid) { return _item.data_uid < _uid; };
+
+            const IndexItem* begin_p = index_p_;
+            const IndexItem* end_p   = index_p_ + index_size_;
+            const IndexItem* it      = std::lower_bound(begin_p, end_p, _data_uid, less);
+            return it != end_p && it->data_uid == _data_uid ? it : nullptr;
+        }
+
+    private:
+        IndexItem*                    index_p_           = nullptr;
+        size_t                        index_size_        = 0;
+        Entry*                        entries_p_         = nullptr;
+        size_t                        entries_size_      = 0;
+        size_t                        usage_             = 0;
+        mutable std::atomic<uint64_t> fingerprint_       = {0};
+        mutable std::atomic<bool>     fingerprint_ready_ = {false};
+    };
+
+} // namespace
+
+IData::SPtrC FreezeSlots(std::vector<std::pair<uint64_t, const EntrySlot*>> _slots)
+{
+    _slots.erase(std::remove_if(_slots.begin(), _slots.end(), [](const auto& _slot) { return !_slot.second->Size(); }),
+                 _slots.end());
+    std::sort(_slots.begin(), _slots.end(), [](const auto& _a, const auto& _b) { return _a.first < _b.first; });
+
+    return FrozenData::Create(_slots);
+}
+
+} // namespace xsdk::xdata::detail
@@ -0,0 +1,147 @@
+#include "xbase/xdata_gather.h"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+namespace xsdk::xdata::detail {
+
+namespace {
+
+    // Chunks of one ParallelFor() call, processed by the calling thread and the pool workers
+    struct Batch {
+        const std::function<void(size_t _begin, size_t _end)>* func_p = nullptr;
+
+        size_t              count  = 0;
+        size_t              chunk  = 0;
+        size_t              chunks = 0;
+        std::atomic<size_t> next   = {0};
+        std::atomic<size_t> done   = {0};
+
+        std::mutex              mtx;
+        std::condition_variable done_cv;
+        std::exception_ptr      error_p;
+
+        // Processes the chunks not taken yet, _func is not touched after all the chunks are taken
+        void Work()
+        {
+            for (auto idx = next.fetch_add(1); idx < chunks; idx = next.fetch_add(1)) {
+                try {
+                    auto begin = idx * chunk;
+                    (*func_p)(begin, std::min(begin + chunk, count));
+                }
+                catch (...) {
+                    std::lock_guard lck(mtx);
+                    if (!error_p)
+                        error_p = std::current_exception();
+                }
+
+                if (done.fetch_add(1) + 1 == chunks) {
+                    std::lock_guard lck(mtx);
+                    done_cv.notify_all();
+                }
+            }
+        }
+
+        void Wait()
+        {
+            std::unique_lock lck(mtx);
+            done_cv.wait(lck, [this] { return done.load() == chunks; });
+        }
+    };
+
+    // Persistent detached workers, started on demand and never stopped (the pool is leaked, so it's usable until the
+    // process exit)
+    class WorkerPool {
+    public:
+        static WorkerPool& Instance()
+        {
+            static auto* pool_p = new WorkerPool();
+            return *pool_p;
+        }
+
+        // Queues the batch for up to _helpers workers, returns count of the workers which may help
+        size_t Post(const std::shared_ptr<Batch>& _batch_sp, size_t _helpers)
+        {
+            std::lock_guard lck(mtx_);
+
+            // Thread creation may fail (e.g. resource limits), continue with the started ones
+            while (workers_ < _helpers) {
+                try {
+                    std::thread([this] { Loop(); }).detach();
+                    ++workers_;
+                }
+                catch (const std::system_error&) {
+                    break;
+                }
+            }
+
+            _helpers = std::min(_helpers, workers_);
+            for (size_t i = 0; i < _helpers; ++i)
+                queue_.push_back(_batch_sp);
+            queue_cv_.notify_all();
+            return _helpers;
+        }
+
+    private:
+        WorkerPool() = default;
+
+        void Loop()
+        {
+            for (;;) {
+                std::shared_ptr<Batch> batch_sp;
+                {
+                    std::unique_lock lck(mtx_);
+                    queue_cv_.wait(lck, [this] { return !queue_.empty(); });
+                    batch_sp = std::move(queue_.front());
+                    queue_.pop_front();
+                }
+
+                // Finished batches left in the queue return immediately
+                batch_sp->Work();
+            }
+        }
+
+    private:
+        std::mutex                         mtx_;
+        std::condition_variable            queue_cv_;
+        std::deque<std::shared_ptr<Batch>> queue_;
+        size_t                             workers_ = 0;
+    };
+
+} // namespace
+
+void ParallelFor(size_t                                                 _count,
+                 size_t                                                 _grain,
+                 const std::function<void(size_t _begin, size_t _end)>& _func,
+                 size_t                                                 _threads)
+{
+    size_t threads = _threads ? _threads : std::max<size_t>(1, std::thread::hardware_concurrency());
+    threads        = std::min(threads, _grain ? _count / _grain : _count);
+    if (threads <= 1) {
+        if (_count)
+            _func(0, _count);
+        return;
+    }
+
+    auto batch_sp    = std::make_shared<Batch>();
+    batch_sp->func_p = &_func;
+    batch_sp->count  = _count;
+    batch_sp->chunk  = (_count + threads - 1) / threads;
+    batch_sp->chunks = (_count + batch_sp->chunk - 1) / batch_sp->chunk;
+
+    // The calling thread takes chunks too, so the call completes even without workers (and nested calls from the
+    // workers don't deadlock), then waits for the chunks taken by the workers
+    WorkerPool::Instance().Post(batch_sp, threads - 1);
+    batch_sp->Work();
+    batch_sp->Wait();
+
+    if (batch_sp->error_p)
+        std::rethrow_exception(batch_sp->error_p);
+}
+
+} // namespace xsdk::xdata::detail
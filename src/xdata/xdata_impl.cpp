@@ -1,107 +1,124 @@
-#include "xdata_impl.h"
+#include "xbase/xdata_core.h"
 
 namespace xsdk {
 
-IData::UPtr xdata::Create() { return IData::UPtr {new impl::XDataImpl()}; }
+IData::UPtr xdata::Create() { return XData::Create(); }
 
-namespace impl {
-
-XDataImpl::XDataImpl(std::map<uint64_t, data_entry>&& _data_map)
-    : uid_(xbase::NextUid()),
-      data_map_(std::move(_data_map))
+IData::UPtr XData::Clone(const xdata::TypeFilter& _filter) const
 {
+    auto cloned_p = XData::Create();
+    cloned_p->budget_.SettingsCopy(budget_);
+    CloneInto(*cloned_p, _filter);
+    return cloned_p;
 }
 
-IData::UPtr XDataImpl::Clone(const std::set<uint64_t>& _cloned_types, CloneSetType _set_type) const
+void XData::CloneInto(IData& _dst, const xdata::TypeFilter& _filter) const
 {
     //std::shared_lock lck(map_rw_);
 
-    std::map<uint64_t, data_entry> cloned_map;
-    if (!_cloned_types.empty()) {
-        if (_set_type == CloneSetType::Exclude) {
-            for (const auto& [type, val] : data_map_) {
-                if (_cloned_types.find(type) != _cloned_types.end())
-                    continue;
+    auto is_cloned = [&](uint64_t _uid) { return _filter.Match(_uid); };
 
-                cloned_map.emplace(type, val);
-            }
+    if (&_dst == this) {
+        auto& self = static_cast<XData&>(_dst);
+        for (auto& [type, val] : self.data_map_) {
+            if (val.Size() && !is_cloned(type))
+                self.budget_.Reset(val);
         }
-        else {
-            assert(_set_type == CloneSetType::Include);
-
-            for (const auto& type_uid : _cloned_types) {
-                auto it = data_map_.find(type_uid);
-                if (it != data_map_.end())
-                    cloned_map.emplace(*it);
-            }
+        return;
+    }
+
+    auto* xdata_p = dynamic_cast<XData*>(&_dst);
+    if (!xdata_p) {
+        _dst.Clear();
+        for (const auto& [type, val] : data_map_) {
+            if (val.Size() && is_cloned(type))
+                xdata::detail::SlotCopyTo(_dst, type, val);
         }
+        return;
     }
-    else if (_set_type == CloneSetType::Exclude) {
-        cloned_map.insert(data_map_.begin(), data_map_.end());
+
+    // Same implementation: copy the slots over the existing ones, so their storage is reused
+    xdata_p->Clear();
+    for (const auto& [type, val] : data_map_) {
+        if (val.Size() && is_cloned(type)) {
+            auto& slot = xdata_p->data_map_[type];
+            slot       = val;
+            xdata_p->budget_.Add(slot);
+        }
     }
 
-    return IData::UPtr {new XDataImpl(std::move(cloned_map))};
+    // The destination keeps its own budget, which may be smaller than the source usage
+    xdata_p->budget_.Fit([xdata_p](auto&& _func) { xdata_p->SlotsForEach(_func); });
 }
 
-size_t XDataImpl::DataSet(uint64_t _data_uid, std::any&& _face, std::any&& _holder, size_t _idx)
+void XData::Clear()
 {
     //std::unique_lock lck(map_rw_);
 
-    auto it = data_map_.find(_data_uid);
-    if (it == data_map_.end())
-        it = data_map_.emplace(_data_uid, data_entry()).first;
-
-    if (_idx >= it->second.size()) {
-        it->second.emplace_back(std::move(_face), std::move(_holder));
-        return it->second.size() - 1;
+    // Slots unused since the previous Clear() are dropped, so the map doesn't grow with every UID ever set
+    for (auto it = data_map_.begin(); it != data_map_.end();) {
+        if (it->second.Reset())
+            ++it;
+        else
+            it = data_map_.erase(it);
     }
-    it->second[_idx].first  = std::move(_face);
-    it->second[_idx].second = std::move(_holder);
-    return _idx;
+    budget_.Clear();
 }
 
-size_t XDataImpl::DataCount(uint64_t _data_uid) const
+IData::SPtrC XData::Freeze() const
 {
     //std::shared_lock lck(map_rw_);
 
-    auto it = data_map_.find(_data_uid);
-    return it == data_map_.end() ? 0 : it->second.size();
-}
-
-std::pair<std::any, std::any> XDataImpl::DataGet(uint64_t _data_uid, size_t _idx) const
-{
-    //std::shared_lock lck(map_rw_);
+    std::vector<std::pair<uint64_t, const xdata::detail::EntrySlot*>> slots;
+    slots.reserve(data_map_.size());
+    for (const auto& [type, val] : data_map_)
+        slots.emplace_back(type, &val);
 
-    auto it = data_map_.find(_data_uid);
-    if (it == data_map_.end() || _idx >= it->second.size())
-        return {};
-
-    return it->second[_idx];
+    return xdata::detail::FreezeSlots(std::move(slots));
 }
 
-std::pair<std::any, std::any> XDataImpl::DataRemove(uint64_t _data_uid, size_t _idx)
+xdata::Entry XData::DataRemoveEntry(uint64_t _data_uid, size_t _idx)
 {
     //std::unique_lock lck(map_rw_);
 
     auto it = data_map_.find(_data_uid);
-    if (it == data_map_.end() || _idx >= it->second.size())
+    if (it == data_map_.end() || _idx >= it->second.Size())
         return {};
 
-    auto removed = std::move(it->second[_idx]);
-    it->second.erase(it->second.begin() + _idx);
+    auto removed = budget_.Take(it->second, _idx);
 
-    if (it->second.empty())
+    if (!it->second.Size())
         data_map_.erase(it);
 
     return removed;
 }
 
-bool XDataImpl::DataReset(uint64_t _data_uid)
+bool XData::DataReset(uint64_t _data_uid)
 {
     //std::unique_lock lck(map_rw_);
 
-    return data_map_.erase(_data_uid) > 0;
+    auto it = data_map_.find(_data_uid);
+    if (it == data_map_.end())
+        return false;
+
+    // Slot may be empty after Clear()
+    auto reset = budget_.Reset(it->second);
+    data_map_.erase(it);
+    return reset;
+}
+
+uint64_t XData::Fingerprint(const xdata::TypeFilter& _filter) const
+{
+    //std::shared_lock lck(map_rw_);
+
+    return fingerprint_.Get(budget_.Revision(), _filter.Key(), [&] {
+        uint64_t fingerprint = 0;
+        for (const auto& [type, val] : data_map_) {
+            if (val.Size() && _filter.Match(type))
+                fingerprint += xdata::detail::SlotHash(type, val);
+        }
+        return fingerprint;
+    });
 }
 
-} // namespace impl
-} // namespace xsdk
\ No newline at end of file
+} // namespace xsdk
@@ -0,0 +1,105 @@
+#include "xbase/xdata_intern.h"
+
+#include <array>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace xsdk::xdata::detail {
+
+namespace {
+
+    // Hash-consing pool, split into shards by value hash for reduce contention
+    class InternPool {
+        static constexpr size_t kShards = 64;
+
+        struct Node {
+            uint64_t                  type_uid;
+            const void*               stored_p;
+            std::weak_ptr<const void> weak;
+        };
+
+        struct Shard {
+            std::mutex                              mtx;
+            std::unordered_multimap<uint64_t, Node> nodes;
+        };
+
+    public:
+        std::shared_ptr<const void> Intern(uint64_t      _type_uid,
+                                           size_t        _hash,
+                                           void*         _value_p,
+                                           InternEqualFn _equal,
+                                           InternMakeFn  _make)
+        {
+            auto  key   = xbase::HashCombine(_type_uid, _hash);
+            auto& shard = shards_[key % kShards];
+
+            // Mismatched instances may be released by another thread while we hold them, their deleter locks the
+            // shard, so they must be released after the lock
+            std::vector<std::shared_ptr<const void>> mismatched;
+
+            std::lock_guard lck(shard.mtx);
+
+            auto [begin, end] = shard.nodes.equal_range(key);
+            for (auto it = begin; it != end; ++it) {
+                if (it->second.type_uid != _type_uid)
+                    continue;
+
+                // Expired instance is removed from the pool by its deleter
+                auto stored_p = it->second.weak.lock();
+                if (!stored_p)
+                    continue;
+                if (_equal(stored_p.get(), _value_p))
+                    return stored_p;
+                mismatched.push_back(std::move(stored_p));
+            }
+
+            auto stored_p = _make(_value_p, _type_uid, _hash);
+            shard.nodes.emplace(key, Node {_type_uid, stored_p.get(), stored_p});
+            return stored_p;
+        }
+
+        void Release(uint64_t _type_uid, size_t _hash, const void* _stored_p)
+        {
+            auto  key   = xbase::HashCombine(_type_uid, _hash);
+            auto& shard = shards_[key % kShards];
+
+            std::lock_guard lck(shard.mtx);
+
+            auto [begin, end] = shard.nodes.equal_range(key);
+            for (auto it = begin; it != end; ++it) {
+                if (it->second.stored_p == _stored_p) {
+                    shard.nodes.erase(it);
+                    return;
+                }
+            }
+        }
+
+    private:
+        std::array<Shard, kShards> shards_;
+    };
+
+    InternPool& Pool()
+    {
+        // Never destroyed: interned values may be released after static destructors
+        static auto* pool_p = new InternPool();
+        return *pool_p;
+    }
+
+} // namespace
+
+std::shared_ptr<const void> Intern(uint64_t      _type_uid,
+                                   size_t        _hash,
+                                   void*         _value_p,
+                                   InternEqualFn _equal,
+                                   InternMakeFn  _make)
+{
+    return Pool().Intern(_type_uid, _hash, _value_p, _equal, _make);
+}
+
+void InternRelease(uint64_t _type_uid, size_t _hash, const void* _stored_p)
+{
+    Pool().Release(_type_uid, _hash, _stored_p);
+}
+
+} // namespace xsdk::xdata::detail
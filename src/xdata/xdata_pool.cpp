@@ -0,0 +1,49 @@
+#include "xbase/xdata_pool.h"
+
+namespace xsdk::xdata {
+
+void Pool::Recycler::operator()(XData* _xdata_p) const noexcept
+{
+    XData::UPtr xdata_p(_xdata_p);
+    auto        state_sp = state_wp.lock();
+    if (!xdata_p || !state_sp)
+        return;
+
+    // Cleared outside of the lock, the entries release may be heavy
+    xdata_p->Clear();
+    xdata_p->BudgetReset();
+
+    std::lock_guard lck(state_sp->mtx);
+    if (state_sp->free.size() < state_sp->max_free)
+        state_sp->free.push_back(std::move(xdata_p));
+}
+
+Pool::Pool(size_t _max_free) : state_p_(std::make_shared<State>())
+{
+    state_p_->max_free = _max_free;
+    state_p_->free.reserve(_max_free);
+}
+
+Pool::Ptr Pool::Acquire()
+{
+    XData::UPtr xdata_p;
+    {
+        std::lock_guard lck(state_p_->mtx);
+        if (!state_p_->free.empty()) {
+            xdata_p = std::move(state_p_->free.back());
+            state_p_->free.pop_back();
+        }
+    }
+    if (!xdata_p)
+        xdata_p = XData::Create();
+
+    return Ptr(xdata_p.release(), Recycler {state_p_});
+}
+
+size_t Pool::FreeCount() const
+{
+    std::lock_guard lck(state_p_->mtx);
+    return state_p_->free.size();
+}
+
+} // namespace xsdk::xdata
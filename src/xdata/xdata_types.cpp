@@ -0,0 +1,166 @@
+#include "xbase/xdata.h"
+
+#include <atomic>
+#include <cassert>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace xsdk::xdata {
+
+namespace {
+
+    // Per-type functions registered by the user, keyed by TypeUid.
+    // Lookups are on the hot path of every DataSetEntry() and Fingerprint(), so the table is copy-on-write: readers
+    // take no locks, just load the current immutable table. Registrations are rare, the replaced tables are kept (as
+    // readers may still use them) until the registry is destroyed.
+    template <typename TFunc>
+    class TypeRegistry {
+        using Table = std::unordered_map<uint64_t, TFunc>;
+
+    public:
+        TypeRegistry() : tables_(1)
+        {
+            tables_.back() = std::make_unique<const Table>();
+            table_p_.store(tables_.back().get(), std::memory_order_release);
+        }
+
+        void Register(uint64_t _type_uid, TFunc&& _func)
+        {
+            std::lock_guard lck(write_mtx_);
+
+            auto table_p = std::make_unique<Table>(*tables_.back());
+            if (_func)
+                (*table_p)[_type_uid] = std::move(_func);
+            else
+                table_p->erase(_type_uid);
+
+            tables_.push_back(std::move(table_p));
+            table_p_.store(tables_.back().get(), std::memory_order_release);
+        }
+
+        // Calls the registered function or returns false if there is no such
+        template <typename TResult, typename... TArgs>
+        bool Call(uint64_t _type_uid, TResult& _result, TArgs&&... _args) const
+        {
+            const auto* table_p = table_p_.load(std::memory_order_acquire);
+            if (table_p->empty())
+                return false;
+
+            auto it = table_p->find(_type_uid);
+            if (it == table_p->end())
+                return false;
+
+            _result = it->second(std::forward<TArgs>(_args)...);
+            return true;
+        }
+
+    private:
+        std::mutex                                write_mtx_;
+        std::vector<std::unique_ptr<const Table>> tables_;
+        std::atomic<const Table*>                 table_p_ = {nullptr};
+    };
+
+    TypeRegistry<std::function<size_t(const void*)>>& Sizers()
+    {
+        static TypeRegistry<std::function<size_t(const void*)>> sizers;
+        return sizers;
+    }
+
+    TypeRegistry<std::function<uint64_t(const void*)>>& Hashers()
+    {
+        static TypeRegistry<std::function<uint64_t(const void*)>> hashers;
+        return hashers;
+    }
+
+    // Operations of the boxed types, for recognize them in std::any received by the legacy IData methods
+    class AnyOpsRegistry {
+    public:
+        void Register(const TypeOps* _ops_p)
+        {
+            std::unique_lock lck(rw_);
+            ops_.emplace(_ops_p->type_uid, _ops_p);
+        }
+
+        const TypeOps* Find(uint64_t _type_uid) const
+        {
+            std::shared_lock lck(rw_);
+
+            auto it = ops_.find(_type_uid);
+            return it == ops_.end() ? nullptr : it->second;
+        }
+
+    private:
+        mutable std::shared_mutex                    rw_;
+        std::unordered_map<uint64_t, const TypeOps*> ops_;
+    };
+
+    AnyOpsRegistry& AnyOps()
+    {
+        // Never destroyed: types may be registered by static initializers of other translation units
+        static auto* registry_p = new AnyOpsRegistry();
+        return *registry_p;
+    }
+
+} // namespace
+
+bool detail::AnyOpsRegister(const TypeOps* _ops_p)
+{
+    AnyOps().Register(_ops_p);
+    return true;
+}
+
+const TypeOps* detail::AnyOpsFind(xbase::Uid _type_uid) { return AnyOps().Find(_type_uid); }
+
+void SizerRegister(uint64_t _type_uid, std::function<size_t(const void*)> _sizer)
+{
+    Sizers().Register(_type_uid, std::move(_sizer));
+}
+
+size_t SizeEstimate(const Box& _box)
+{
+    const auto* ops_p = _box.Ops();
+    if (!ops_p)
+        return 0;
+
+    // The size is unknown until the value is computed, and the estimate is never refreshed after that,
+    // so lazy values are not accounted at all instead of misleading sizeof(T)
+    if (ops_p->lazy)
+        return 0;
+
+    size_t size = 0;
+    if (Sizers().Call(ops_p->type_uid, size, _box.Ptr().get()))
+        return size;
+
+    return ops_p->size_of;
+}
+
+void HasherRegister(uint64_t _type_uid, std::function<uint64_t(const void*)> _hasher)
+{
+    Hashers().Register(_type_uid, std::move(_hasher));
+}
+
+uint64_t HashCompute(const Box& _box)
+{
+    const auto* ops_p = _box.Ops();
+    if (!ops_p)
+        return 0;
+
+    // Registered hasher takes precedence over the default one
+    uint64_t hash = 0;
+    if (!Hashers().Call(ops_p->type_uid, hash, _box.Ptr().get())) {
+        if (!ops_p->hash) {
+            // Legacy values are skipped, typed values must be hashable (see HasherRegister())
+            assert(ops_p->type_uid == xbase::TypeUid<detail::LegacyAny>() && "xdata: no hasher for the type");
+            return 0;
+        }
+        hash = ops_p->hash(_box.Ptr().get());
+    }
+
+    // 0 is reserved for the values without hash
+    hash = xbase::HashCombine(ops_p->type_uid, hash);
+    return hash ? hash : 1;
+}
+
+} // namespace xsdk::xdata
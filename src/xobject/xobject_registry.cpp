@@ -0,0 +1,132 @@
+#include "xbase/xobject.h"
+
+#include <array>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace xsdk::xobject {
+
+namespace {
+
+    // Global registry of the objects, split into stripes by UID for reduce contention
+    class Registry {
+        static constexpr size_t kStripes = 64;
+
+        struct Node {
+            IObject::WPtr obj_wp;
+            uint64_t      serial;
+        };
+
+        // Aligned for avoid false sharing of the stripes locks
+        struct alignas(64) Stripe {
+            mutable std::shared_mutex          rw;
+            std::unordered_map<uint64_t, Node> nodes;
+        };
+
+    public:
+        uint64_t Add(const IObject::SPtr& _obj_sp)
+        {
+            auto  serial = xbase::NextUid();
+            auto  uid    = _obj_sp->ObjectUid();
+            auto& stripe = StripeGet(uid);
+
+            std::unique_lock lck(stripe.rw);
+            stripe.nodes.insert_or_assign(uid, Node {_obj_sp, serial});
+            return serial;
+        }
+
+        void Remove(uint64_t _object_uid, uint64_t _serial)
+        {
+            auto& stripe = StripeGet(_object_uid);
+
+            // Destroyed outside of the lock
+            IObject::WPtr removed_wp;
+
+            std::unique_lock lck(stripe.rw);
+            auto             it = stripe.nodes.find(_object_uid);
+            if (it != stripe.nodes.end() && it->second.serial == _serial) {
+                removed_wp = std::move(it->second.obj_wp);
+                stripe.nodes.erase(it);
+            }
+        }
+
+        IObject::SPtr Find(uint64_t _object_uid) const
+        {
+            const auto& stripe = StripeGet(_object_uid);
+
+            IObject::WPtr obj_wp;
+            {
+                std::shared_lock lck(stripe.rw);
+                auto             it = stripe.nodes.find(_object_uid);
+                if (it == stripe.nodes.end())
+                    return nullptr;
+                obj_wp = it->second.obj_wp;
+            }
+            // The object destructor may deregister it, so lock() result must be released outside of the stripe lock
+            return obj_wp.lock();
+        }
+
+        std::vector<IObject::SPtr> Snapshot() const
+        {
+            std::vector<IObject::SPtr> objects;
+            std::vector<IObject::WPtr> stripe_objects;
+            for (const auto& stripe : stripes_) {
+                stripe_objects.clear();
+                {
+                    std::shared_lock lck(stripe.rw);
+                    stripe_objects.reserve(stripe.nodes.size());
+                    for (const auto& [uid, node] : stripe.nodes)
+                        stripe_objects.push_back(node.obj_wp);
+                }
+                for (const auto& obj_wp : stripe_objects) {
+                    if (auto obj_sp = obj_wp.lock())
+                        objects.push_back(std::move(obj_sp));
+                }
+            }
+            return objects;
+        }
+
+    private:
+        Stripe&       StripeGet(uint64_t _object_uid) { return stripes_[Mix(_object_uid) % kStripes]; }
+        const Stripe& StripeGet(uint64_t _object_uid) const { return stripes_[Mix(_object_uid) % kStripes]; }
+
+        // Object UIDs are often sequential, mix them for spread over the stripes
+        static uint64_t Mix(uint64_t _uid) { return (_uid * 0x9e3779b97f4a7c15) >> 32; }
+
+    private:
+        std::array<Stripe, kStripes> stripes_;
+    };
+
+    Registry& RegistryGet()
+    {
+        // Never destroyed: registrations may be released after static destructors
+        static auto* registry_p = new Registry();
+        return *registry_p;
+    }
+
+} // namespace
+
+void Registration::Reset() noexcept
+{
+    if (!serial_)
+        return;
+
+    RegistryGet().Remove(object_uid_, serial_);
+    serial_ = 0;
+}
+
+Registration Register(const IObject::SPtr& _obj_sp)
+{
+    if (!_obj_sp)
+        return {};
+
+    auto serial = RegistryGet().Add(_obj_sp);
+    return Registration(_obj_sp->ObjectUid(), serial);
+}
+
+IObject::SPtr Find(uint64_t _object_uid) { return RegistryGet().Find(_object_uid); }
+
+std::vector<IObject::SPtr> Snapshot() { return RegistryGet().Snapshot(); }
+
+} // namespace xsdk::xobject
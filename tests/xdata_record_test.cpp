@@ -0,0 +1,74 @@
+#include "xbase.h"
+
+#include <gtest/gtest.h>
+
+using namespace xsdk;
+
+// NOLINTBEGIN(*)
+
+namespace {
+
+struct VideoFormat {
+    int width  = 0;
+    int height = 0;
+};
+
+using FrameRecord = xdata::Record<int64_t, VideoFormat>;
+
+} // namespace
+
+TEST(xdata_record_tests, typed_access)
+{
+    auto record_p = std::make_unique<FrameRecord>();
+
+    static_assert(FrameRecord::kHasField<int64_t>);
+    static_assert(!FrameRecord::kHasField<std::string>);
+
+    EXPECT_EQ(xdata::Set(record_p.get(), -1, int64_t(10)), 0);
+    EXPECT_EQ(xdata::Set(record_p.get(), -1, int64_t(20)), 1);
+    EXPECT_EQ(xdata::Set(record_p.get(), -1, VideoFormat {1920, 1080}), 0);
+    EXPECT_EQ(xdata::Set(record_p.get(), -1, std::string("overflow")), 0);
+
+    EXPECT_EQ(xdata::Count<int64_t>(record_p.get()), 2);
+    EXPECT_EQ(xdata::Count<std::string>(record_p.get()), 1);
+    EXPECT_EQ(xdata::Count<double>(record_p.get()), 0);
+
+    EXPECT_EQ(xdata::GetCopy<int64_t>(record_p.get(), 1), 20);
+    ASSERT_TRUE(xdata::Peek<VideoFormat>(record_p.get()));
+    EXPECT_EQ(xdata::Peek<VideoFormat>(record_p.get())->height, 1080);
+    auto str_sp = xdata::Get<std::string>(record_p.get());
+    ASSERT_TRUE(str_sp);
+    EXPECT_EQ(*str_sp, "overflow");
+
+    // The same data through IData
+    const IData* data_p = record_p.get();
+    EXPECT_EQ(xdata::Count<int64_t>(data_p), 2);
+    EXPECT_EQ(xdata::GetCopy<int64_t>(data_p), 10);
+    EXPECT_EQ(xdata::GetCopy<std::string>(data_p), "overflow");
+}
+
+TEST(xdata_record_tests, idata_compatibility)
+{
+    IData::UPtr data_p = std::make_unique<FrameRecord>();
+
+    EXPECT_EQ(xdata::Set(data_p.get(), -1, int64_t(1)), 0);
+    EXPECT_EQ(xdata::Set(data_p.get(), -1, int64_t(2)), 1);
+    EXPECT_EQ(xdata::Set(data_p.get(), -1, int64_t(3)), 2);
+    EXPECT_EQ(xdata::Set(data_p.get(), -1, 1.5), 0);
+
+    auto removed = data_p->DataRemoveEntry(xbase::TypeUid<int64_t>(), 0);
+    EXPECT_EQ(*removed.face.Peek<int64_t>(), 1);
+    EXPECT_EQ(xdata::GetCopyVec<int64_t>(data_p.get()), (std::vector<int64_t> {2, 3}));
+
+    auto clone_p = data_p->Clone({xbase::TypeUid<double>()}, IData::CloneSetType::Exclude);
+    ASSERT_TRUE(dynamic_cast<FrameRecord*>(clone_p.get()));
+    EXPECT_EQ(xdata::Count<int64_t>(clone_p.get()), 2);
+    EXPECT_EQ(xdata::Count<double>(clone_p.get()), 0);
+
+    EXPECT_TRUE(data_p->DataReset(xbase::TypeUid<int64_t>()));
+    EXPECT_FALSE(data_p->DataReset(xbase::TypeUid<int64_t>()));
+    EXPECT_EQ(xdata::Count<int64_t>(data_p.get()), 0);
+    EXPECT_EQ(xdata::Count<int64_t>(clone_p.get()), 2);
+}
+
+// NOLINTEND(*)
@@ -1,8 +1,11 @@
 #include "xbase.h"
 
 #include <gtest/gtest.h>
+
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <stdexcept>
 #include <thread>
 
 // TEMP
@@ -10,6 +13,7 @@
 // #include "../../include/xutils/utils_vectors.h"
 
 using namespace xsdk;
+using namespace xsdk::xdata::literals;
 
 // NOLINTBEGIN(*)
 
@@ -94,6 +98,733 @@ TEST(xdata_tests, data_clone_include)
     EXPECT_EQ(xdata::Count<double>(clone_sp.get()), 1);
 }
 
+TEST(xdata_tests, data_entry)
+{
+    auto data_sp = xdata::Create();
+
+    auto idx = xdata::Set(data_sp.get(), -1, int64_t(42), std::string("holder"));
+    EXPECT_EQ(idx, 0);
+
+    const auto* entry_p = data_sp->DataGetEntry(xbase::TypeUid<int64_t>());
+    ASSERT_TRUE(entry_p);
+    EXPECT_EQ(entry_p->version, xdata::kEntryVersion);
+    EXPECT_EQ(entry_p->face.TypeId(), xbase::TypeUid<int64_t>());
+    EXPECT_EQ(entry_p->holder.TypeId(), xbase::TypeUid<std::string>());
+    ASSERT_TRUE(entry_p->face.Peek<int64_t>());
+    EXPECT_EQ(*entry_p->face.Peek<int64_t>(), 42);
+    EXPECT_FALSE(entry_p->face.Peek<int32_t>());
+    EXPECT_EQ(entry_p, data_sp->DataGetEntry(xbase::TypeUid<int64_t>()));
+    EXPECT_FALSE(data_sp->DataGetEntry(xbase::TypeUid<int64_t>(), 1));
+
+    auto [int_sp, holder_sp] = xdata::GetWithHolder<int64_t, std::string>(data_sp.get());
+    ASSERT_TRUE(int_sp);
+    ASSERT_TRUE(holder_sp);
+    EXPECT_EQ(*int_sp, 42);
+    EXPECT_EQ(*holder_sp, "holder");
+
+    auto removed = data_sp->DataRemoveEntry(xbase::TypeUid<int64_t>());
+    EXPECT_EQ(*removed.face.Peek<int64_t>(), 42);
+    EXPECT_EQ(xdata::Count<int64_t>(data_sp.get()), 0);
+}
+
+TEST(xdata_tests, data_legacy_any)
+{
+    auto data_sp = xdata::Create();
+
+    // Const shared pointer stored via legacy API is found by the typed helpers
+    std::shared_ptr<const std::string> const_sp = std::make_shared<std::string>("const");
+    data_sp->DataSet(xbase::TypeUid<std::string>(), const_sp, std::make_shared<int>(5));
+
+    auto str_sp = xdata::Get<std::string>(data_sp.get());
+    ASSERT_TRUE(str_sp);
+    EXPECT_EQ(str_sp, const_sp);
+    auto [face_sp, holder_sp] = xdata::GetWithHolder<std::string, int>(data_sp.get());
+    EXPECT_EQ(face_sp, const_sp);
+    ASSERT_TRUE(holder_sp);
+    EXPECT_EQ(*holder_sp, 5);
+
+    // Typed entries are visible through the legacy API
+    xdata::Set(data_sp.get(), -1, 1.5);
+    auto [face, holder] = data_sp->DataGet(xbase::TypeUid<double>());
+    const auto* double_p = xdata::AnyUnwrap<double>(face);
+    ASSERT_TRUE(double_p);
+    EXPECT_EQ(*double_p, 1.5);
+    EXPECT_FALSE(holder.has_value());
+
+    auto [removed_face, removed_holder] = data_sp->DataRemove(xbase::TypeUid<double>());
+    EXPECT_TRUE(xdata::AnyUnwrap<double>(removed_face));
+    EXPECT_EQ(xdata::Count<double>(data_sp.get()), 0);
+
+    // Shared pointers of the expected type are boxed typed, with the constness kept for the legacy API
+    const auto* str_entry_p = data_sp->DataGetEntry(xbase::TypeUid<std::string>());
+    ASSERT_TRUE(str_entry_p);
+    EXPECT_EQ(str_entry_p->face.TypeId(), xbase::TypeUid<std::string>());
+    auto [str_face, str_holder] = data_sp->DataGet(xbase::TypeUid<std::string>());
+    EXPECT_TRUE(std::any_cast<std::shared_ptr<const std::string>>(&str_face));
+
+    data_sp->DataSet(xbase::TypeUid<int64_t>(), xdata::AnyWrap(int64_t(7)));
+    const auto* int_entry_p = data_sp->DataGetEntry(xbase::TypeUid<int64_t>());
+    ASSERT_TRUE(int_entry_p);
+    EXPECT_EQ(int_entry_p->face.TypeId(), xbase::TypeUid<int64_t>());
+    EXPECT_EQ(*xdata::AnyUnwrap<int64_t>(data_sp->DataGet(xbase::TypeUid<int64_t>()).first), 7);
+
+    // Other values are wrapped as is
+    data_sp->DataSet(xbase::TypeUid<float>(), std::any(1.5f));
+    const auto* float_entry_p = data_sp->DataGetEntry(xbase::TypeUid<float>());
+    ASSERT_TRUE(float_entry_p);
+    EXPECT_EQ(float_entry_p->face.TypeId(), xbase::TypeUid<xdata::detail::LegacyAny>());
+    EXPECT_EQ(std::any_cast<float>(data_sp->DataGet(xbase::TypeUid<float>()).first), 1.5f);
+}
+
+TEST(xdata_tests, data_named_keys)
+{
+    auto data_sp = xdata::Create();
+
+    static_assert(xdata::KeyUid<int64_t>("pts"_key) != xdata::KeyUid<int64_t>("dts"_key));
+    static_assert(xdata::KeyUid<int64_t>("pts"_key) != xdata::KeyUid<double>("pts"_key));
+    static_assert(xdata::KeyUid<int64_t>("pts"_key) != xbase::TypeUid<int64_t>());
+
+    EXPECT_EQ(xdata::Set(data_sp.get(), "pts"_key, -1, int64_t(100)), 0);
+    EXPECT_EQ(xdata::Set(data_sp.get(), "dts"_key, -1, int64_t(90)), 0);
+    EXPECT_EQ(xdata::Set(data_sp.get(), "dts"_key, -1, int64_t(91)), 1);
+    EXPECT_EQ(xdata::Set(data_sp.get(), -1, int64_t(1)), 0);
+
+    EXPECT_EQ(xdata::Count<int64_t>(data_sp.get(), "pts"_key), 1);
+    EXPECT_EQ(xdata::Count<int64_t>(data_sp.get(), "dts"_key), 2);
+    EXPECT_EQ(xdata::Count<int64_t>(data_sp.get()), 1);
+    EXPECT_EQ(xdata::Count<double>(data_sp.get(), "pts"_key), 0);
+
+    EXPECT_EQ(xdata::GetCopy<int64_t>(data_sp.get(), "pts"_key), 100);
+    EXPECT_EQ(xdata::GetCopy<int64_t>(data_sp.get(), "dts"_key, 1), 91);
+    EXPECT_EQ(xdata::GetCopy<int64_t>(data_sp.get()), 1);
+    EXPECT_FALSE(xdata::Get<double>(data_sp.get(), "pts"_key));
+    auto pts_sp = xdata::Get<int64_t>(data_sp.get(), "pts"_key);
+    ASSERT_TRUE(pts_sp);
+    EXPECT_EQ(*pts_sp, 100);
+
+    auto clone_sp = data_sp->Clone({xdata::KeyUid<int64_t>("dts"_key)}, IData::CloneSetType::Include);
+    EXPECT_EQ(xdata::Count<int64_t>(clone_sp.get(), "dts"_key), 2);
+    EXPECT_EQ(xdata::Count<int64_t>(clone_sp.get(), "pts"_key), 0);
+}
+
+TEST(xdata_tests, data_memory_usage)
+{
+    using Buffer = std::vector<uint8_t>;
+    xdata::SizerRegister<Buffer>([](const Buffer& _buf) { return sizeof(Buffer) + _buf.capacity(); });
+
+    auto data_sp = xdata::Create();
+    EXPECT_EQ(data_sp->DataMemoryUsage(), 0);
+
+    xdata::Set(data_sp.get(), -1, int64_t(1));
+    EXPECT_EQ(data_sp->DataMemoryUsage(), sizeof(int64_t));
+    xdata::Set(data_sp.get(), -1, int64_t(2), Buffer(1000));
+    EXPECT_EQ(data_sp->DataMemoryUsage(), 2 * sizeof(int64_t) + sizeof(Buffer) + 1000);
+
+    auto clone_sp = data_sp->Clone();
+    EXPECT_EQ(clone_sp->DataMemoryUsage(), data_sp->DataMemoryUsage());
+
+    data_sp->DataRemoveEntry(xbase::TypeUid<int64_t>(), 1);
+    EXPECT_EQ(data_sp->DataMemoryUsage(), sizeof(int64_t));
+    data_sp->DataReset(xbase::TypeUid<int64_t>());
+    EXPECT_EQ(data_sp->DataMemoryUsage(), 0);
+
+    // Sizers may be registered concurrently with the containers use
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([] {
+            auto local_sp = xdata::Create();
+            for (int i = 0; i < 1000; ++i)
+                xdata::Set(local_sp.get(), 0, Buffer(16));
+        });
+    }
+    for (int i = 0; i < 50; ++i) {
+        xdata::SizerRegister<int64_t>([](const int64_t&) { return sizeof(int64_t); });
+        xdata::SizerRegister<int64_t>(nullptr);
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    xdata::SizerRegister<Buffer>(nullptr);
+}
+
+TEST(xdata_tests, data_budget_eviction)
+{
+    auto data_sp = xdata::Create();
+    data_sp->DataBudgetSet(3 * sizeof(int64_t), IData::EvictPolicy::OldestFirst);
+
+    xdata::Set(data_sp.get(), -1, 1.0);
+    for (int64_t i = 0; i < 5; ++i)
+        xdata::Set(data_sp.get(), -1, i);
+
+    // The oldest entries of the whole container are evicted
+    EXPECT_EQ(xdata::Count<double>(data_sp.get()), 0);
+    EXPECT_EQ(xdata::GetCopyVec<int64_t>(data_sp.get()), (std::vector<int64_t> {2, 3, 4}));
+    EXPECT_EQ(data_sp->DataMemoryUsage(), 3 * sizeof(int64_t));
+
+    // Single entries of different types
+    auto mixed_sp = xdata::Create();
+    mixed_sp->DataBudgetSet(16);
+    xdata::Set(mixed_sp.get(), -1, int64_t(1));
+    xdata::Set(mixed_sp.get(), -1, 1.0);
+    xdata::Set(mixed_sp.get(), -1, int32_t(1));
+    xdata::Set(mixed_sp.get(), -1, 1.0f);
+    EXPECT_LE(mixed_sp->DataMemoryUsage(), 16);
+    EXPECT_EQ(xdata::Count<int64_t>(mixed_sp.get()), 0);
+    EXPECT_EQ(xdata::Count<float>(mixed_sp.get()), 1);
+
+    // Pinned entries are not evicted
+    auto pinned_sp = xdata::Create();
+    pinned_sp->DataBudgetSet(3 * sizeof(int64_t), IData::EvictPolicy::OldestFirst);
+    pinned_sp->DataBudgetPolicySet(xbase::TypeUid<double>(), IData::EvictPolicy::Never);
+    xdata::Set(pinned_sp.get(), -1, 1.0);
+    for (int64_t i = 0; i < 5; ++i)
+        xdata::Set(pinned_sp.get(), -1, i);
+    EXPECT_EQ(xdata::Count<double>(pinned_sp.get()), 1);
+    EXPECT_EQ(xdata::GetCopyVec<int64_t>(pinned_sp.get()), (std::vector<int64_t> {3, 4}));
+    EXPECT_EQ(pinned_sp->Clone()->Fingerprint(), pinned_sp->Fingerprint());
+
+    // Entries which can't fit are rejected without changes
+    pinned_sp->DataBudgetPolicySet(xbase::TypeUid<int64_t>(), IData::EvictPolicy::Never);
+    EXPECT_EQ(xdata::Set(pinned_sp.get(), -1, int64_t(5)), size_t(-1));
+    EXPECT_EQ(xdata::GetCopyVec<int64_t>(pinned_sp.get()), (std::vector<int64_t> {3, 4}));
+    EXPECT_EQ(xdata::Set(pinned_sp.get(), 0, int64_t(5)), 0); // Replace fits
+    EXPECT_EQ(xdata::Set(data_sp.get(), -1, std::array<int64_t, 4> {}), size_t(-1));
+    EXPECT_EQ(xdata::GetCopyVec<int64_t>(data_sp.get()), (std::vector<int64_t> {2, 3, 4}));
+
+    auto lru_sp = xdata::Create();
+    lru_sp->DataBudgetSet(3 * sizeof(int64_t), IData::EvictPolicy::Lru);
+    for (int64_t i = 0; i < 3; ++i)
+        xdata::Set(lru_sp.get(), -1, i);
+    EXPECT_EQ(xdata::GetCopy<int64_t>(lru_sp.get(), 0), 0); // 0 becomes the most recently used
+    xdata::Set(lru_sp.get(), -1, int64_t(3));
+    EXPECT_EQ(xdata::GetCopyVec<int64_t>(lru_sp.get()), (std::vector<int64_t> {0, 2, 3}));
+
+    // Per-type policy: reads of OldestFirst type don't protect it
+    lru_sp->DataBudgetPolicySet(xbase::TypeUid<int64_t>(), IData::EvictPolicy::OldestFirst);
+    EXPECT_EQ(xdata::GetCopy<int64_t>(lru_sp.get(), 0), 0);
+    xdata::Set(lru_sp.get(), -1, int64_t(4));
+    EXPECT_EQ(xdata::GetCopyVec<int64_t>(lru_sp.get()), (std::vector<int64_t> {2, 3, 4}));
+
+    auto record_p = std::make_unique<xdata::Record<int64_t>>();
+    record_p->DataBudgetSet(2 * sizeof(int64_t), IData::EvictPolicy::OldestFirst);
+    xdata::Set(record_p.get(), -1, 1.0);
+    for (int64_t i = 0; i < 4; ++i)
+        xdata::Set(record_p.get(), -1, i);
+    EXPECT_EQ(xdata::Count<double>(record_p.get()), 0);
+    EXPECT_EQ(xdata::GetCopyVec<int64_t>(record_p.get()), (std::vector<int64_t> {2, 3}));
+    EXPECT_EQ(record_p->DataMemoryUsage(), 2 * sizeof(int64_t));
+
+    // Cloned entries are older than the entries set after the clone
+    std::vector<IData::UPtr> sources;
+    sources.push_back(xdata::Create());
+    sources.push_back(std::make_unique<xdata::Record<int64_t>>());
+    for (const auto& source_p : sources) {
+        source_p->DataBudgetSet(3 * sizeof(int64_t), IData::EvictPolicy::OldestFirst);
+        for (int64_t i : {10, 20, 100})
+            xdata::Set(source_p.get(), -1, i);
+
+        auto cloned_p = source_p->Clone();
+        for (int64_t i = 1; i <= 3; ++i)
+            xdata::Set(cloned_p.get(), -1, i);
+        EXPECT_EQ(xdata::GetCopyVec<int64_t>(cloned_p.get()), (std::vector<int64_t> {1, 2, 3}));
+    }
+
+    // Budget of the clone destination is enforced
+    auto large_sp = xdata::Create();
+    for (int64_t i = 0; i < 10; ++i)
+        xdata::Set(large_sp.get(), -1, i);
+    xdata::Set(large_sp.get(), -1, 1.5);
+    for (const auto& dst_p : sources) {
+        dst_p->DataBudgetSet(2 * sizeof(int64_t), IData::EvictPolicy::OldestFirst);
+        large_sp->CloneInto(*dst_p);
+        EXPECT_EQ(dst_p->DataMemoryUsage(), 2 * sizeof(int64_t));
+        EXPECT_EQ(xdata::Count<int64_t>(dst_p.get()) + xdata::Count<double>(dst_p.get()), 2);
+        EXPECT_EQ(xdata::GetCopyVec<int64_t>(dst_p.get()).back(), 9);
+
+        // Not evictable entries which don't fit are not cloned, like rejected by DataSetEntry()
+        dst_p->DataBudgetPolicySet(xbase::TypeUid<int64_t>(), IData::EvictPolicy::Never);
+        large_sp->CloneInto(*dst_p);
+        EXPECT_EQ(xdata::GetCopyVec<int64_t>(dst_p.get()), (std::vector<int64_t> {0, 1}));
+        EXPECT_EQ(xdata::Count<double>(dst_p.get()), 0);
+        EXPECT_EQ(dst_p->DataMemoryUsage(), 2 * sizeof(int64_t));
+    }
+}
+
+TEST(xdata_tests, data_intern)
+{
+    auto first_sp  = xdata::Intern(std::string("format"));
+    auto second_sp = xdata::Intern(std::string("format"));
+    auto other_sp  = xdata::Intern(std::string("other"));
+    ASSERT_TRUE(first_sp);
+    EXPECT_EQ(first_sp, second_sp);
+    EXPECT_NE(first_sp, other_sp);
+    EXPECT_EQ(*other_sp, "other");
+
+    auto frame_sp = xdata::Create();
+    auto next_sp  = xdata::Create();
+    EXPECT_EQ(xdata::SetShared(frame_sp.get(), -1, first_sp), 0);
+    EXPECT_EQ(xdata::SetShared(next_sp.get(), -1, xdata::Intern(std::string("format"))), 0);
+    EXPECT_EQ(xdata::Get<std::string>(frame_sp.get()), xdata::Get<std::string>(next_sp.get()));
+    EXPECT_TRUE(xdata::Equal<std::string>(frame_sp.get(), next_sp.get()));
+
+    // Shared instance is not writable through the legacy API
+    auto [legacy_face, legacy_holder] = frame_sp->DataGet(xbase::TypeUid<std::string>());
+    EXPECT_FALSE(std::any_cast<std::shared_ptr<std::string>>(&legacy_face));
+    ASSERT_TRUE(std::any_cast<std::shared_ptr<const std::string>>(&legacy_face));
+    EXPECT_EQ(std::any_cast<std::shared_ptr<const std::string>>(legacy_face), first_sp);
+    EXPECT_EQ(xdata::AnyUnwrap<std::string>(legacy_face), first_sp.get());
+
+    xdata::Set(next_sp.get(), 0, std::string("format"));
+    EXPECT_NE(xdata::Get<std::string>(frame_sp.get()), xdata::Get<std::string>(next_sp.get()));
+    EXPECT_TRUE(xdata::Equal<std::string>(frame_sp.get(), next_sp.get()));
+    EXPECT_TRUE(xdata::Equal<std::string>(frame_sp.get(), next_sp.get(), 1)); // both missing
+    xdata::Set(next_sp.get(), 0, std::string("changed"));
+    EXPECT_FALSE(xdata::Equal<std::string>(frame_sp.get(), next_sp.get()));
+
+    // Released instance is removed from the pool and can be interned again
+    other_sp.reset();
+    other_sp = xdata::Intern(std::string("other"));
+    ASSERT_TRUE(other_sp);
+    EXPECT_EQ(*other_sp, "other");
+}
+
+TEST(xdata_tests, data_intern_concurrent)
+{
+    std::vector<std::thread>                        threads;
+    std::vector<std::shared_ptr<const std::string>> results(8);
+    for (size_t t = 0; t < results.size(); ++t) {
+        threads.emplace_back([&results, t] {
+            for (int i = 0; i < 1000; ++i)
+                results[t] = xdata::Intern(std::string("value ") + std::to_string(i % 10));
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    for (const auto& result : results)
+        EXPECT_EQ(result, results.front());
+}
+
+TEST(xdata_tests, data_lazy)
+{
+    auto data_sp = xdata::Create();
+
+    std::atomic<int> calls = 0;
+    EXPECT_EQ(xdata::SetLazy<std::string>(data_sp.get(),
+                                          -1,
+                                          [&calls] {
+                                              ++calls;
+                                              return std::string("computed");
+                                          }),
+              0);
+    EXPECT_EQ(xdata::Count<std::string>(data_sp.get()), 1);
+    EXPECT_EQ(data_sp->DataMemoryUsage(), 0); // Lazy items are not accounted
+
+    auto clone_sp = data_sp->Clone();
+    EXPECT_EQ(calls, 0);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&data_sp] {
+            auto str_sp = xdata::Get<std::string>(data_sp.get());
+            ASSERT_TRUE(str_sp);
+            EXPECT_EQ(*str_sp, "computed");
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    EXPECT_EQ(calls, 1);
+
+    // The clone shares the computed value
+    EXPECT_EQ(xdata::Get<std::string>(clone_sp.get()), xdata::Get<std::string>(data_sp.get()));
+    EXPECT_EQ(xdata::GetCopy<std::string>(clone_sp.get()), "computed");
+    auto [face, holder] = clone_sp->DataGet(xbase::TypeUid<std::string>());
+    ASSERT_TRUE(xdata::AnyUnwrap<std::string>(face));
+    EXPECT_EQ(*xdata::AnyUnwrap<std::string>(face), "computed");
+    EXPECT_EQ(calls, 1);
+
+    // Lazy items stay unaccounted after the computation and are never evicted
+    EXPECT_EQ(data_sp->DataMemoryUsage(), 0);
+    data_sp->DataBudgetSet(sizeof(int64_t), IData::EvictPolicy::OldestFirst);
+    xdata::Set(data_sp.get(), -1, int64_t(1));
+    xdata::Set(data_sp.get(), -1, int64_t(2));
+    EXPECT_EQ(xdata::Count<std::string>(data_sp.get()), 1);
+    EXPECT_EQ(xdata::GetCopyVec<int64_t>(data_sp.get()), std::vector<int64_t> {2});
+    EXPECT_EQ(data_sp->DataMemoryUsage(), sizeof(int64_t));
+}
+
+TEST(xdata_tests, data_fingerprint)
+{
+    auto data_sp  = xdata::Create();
+    auto other_sp = xdata::Create();
+    EXPECT_EQ(data_sp->Fingerprint(), other_sp->Fingerprint());
+
+    xdata::Set(data_sp.get(), -1, int64_t(1));
+    xdata::Set(data_sp.get(), -1, std::string("abc"));
+    xdata::Set(other_sp.get(), -1, std::string("abc"));
+    xdata::Set(other_sp.get(), -1, int64_t(1));
+
+    auto fingerprint = data_sp->Fingerprint();
+    EXPECT_EQ(fingerprint, data_sp->Fingerprint());
+    EXPECT_EQ(fingerprint, other_sp->Fingerprint());
+    EXPECT_EQ(fingerprint, data_sp->Clone()->Fingerprint());
+
+    // Same content in Record gives the same fingerprint
+    auto record_p = std::make_unique<xdata::Record<int64_t>>();
+    xdata::Set(record_p.get(), -1, int64_t(1));
+    xdata::Set(record_p.get(), -1, std::string("abc"));
+    EXPECT_EQ(fingerprint, record_p->Fingerprint());
+
+    xdata::Set(other_sp.get(), 0, int64_t(2));
+    EXPECT_NE(fingerprint, other_sp->Fingerprint());
+
+    // Filtered fingerprint
+    std::set<uint64_t> types {xbase::TypeUid<std::string>()};
+    EXPECT_EQ(data_sp->Fingerprint(types, IData::CloneSetType::Include),
+              other_sp->Fingerprint(types, IData::CloneSetType::Include));
+    EXPECT_NE(data_sp->Fingerprint(types, IData::CloneSetType::Exclude),
+              other_sp->Fingerprint(types, IData::CloneSetType::Exclude));
+
+    // Registered hasher
+    struct Padded {
+        char    c;
+        int64_t v;
+    };
+    xdata::HasherRegister<Padded>([](const Padded& _val) { return xbase::HashCombine(_val.c, _val.v); });
+    xdata::Set(data_sp.get(), -1, Padded {'a', 1});
+    xdata::Set(other_sp.get(), -1, Padded {'a', 1});
+    EXPECT_EQ(data_sp->Fingerprint({xbase::TypeUid<Padded>()}, IData::CloneSetType::Include),
+              other_sp->Fingerprint({xbase::TypeUid<Padded>()}, IData::CloneSetType::Include));
+    xdata::HasherRegister<Padded>(nullptr);
+
+    // Equal values are hashed by content, not by address
+    auto vec_sp       = xdata::Create();
+    auto other_vec_sp = xdata::Create();
+    xdata::Set(vec_sp.get(), -1, std::vector<int> {1, 2, 3});
+    xdata::Set(other_vec_sp.get(), -1, std::vector<int> {1, 2, 3});
+    EXPECT_EQ(vec_sp->Fingerprint(), other_vec_sp->Fingerprint());
+    xdata::Set(other_vec_sp.get(), 0, std::vector<int> {1, 2});
+    EXPECT_NE(vec_sp->Fingerprint(), other_vec_sp->Fingerprint());
+
+    // Strings are hashed by characters, floating point values by value
+    std::string first("text"), second("text");
+    auto        view_sp       = xdata::Create();
+    auto        other_view_sp = xdata::Create();
+    xdata::Set(view_sp.get(), -1, std::string_view(first));
+    xdata::Set(other_view_sp.get(), -1, std::string_view(second));
+    xdata::Set(view_sp.get(), -1, first.c_str());
+    xdata::Set(other_view_sp.get(), -1, second.c_str());
+    xdata::Set(view_sp.get(), -1, 0.0);
+    xdata::Set(other_view_sp.get(), -1, -0.0);
+    EXPECT_EQ(view_sp->Fingerprint(), other_view_sp->Fingerprint());
+    xdata::Set(other_view_sp.get(), 0, "other");
+    EXPECT_NE(view_sp->Fingerprint(), other_view_sp->Fingerprint());
+
+    // Identities and padding have no default hash
+    static_assert(!xdata::detail::IsDefaultHashable<std::shared_ptr<int>>());
+    static_assert(!xdata::detail::IsDefaultHashable<const int*>());
+    static_assert(!xdata::detail::IsDefaultHashable<Padded>());
+    static_assert(xdata::detail::IsDefaultHashable<std::vector<double>>());
+
+    // Opaque legacy values are skipped
+    auto legacy_sp = xdata::Create();
+    legacy_sp->DataSet(xbase::TypeUid<float>(), std::any(1.5f));
+    EXPECT_EQ(legacy_sp->Fingerprint(), xdata::Create()->Fingerprint());
+    legacy_sp->DataSet(xbase::TypeUid<int64_t>(), xdata::AnyWrap(int64_t(1)));
+    auto typed_sp = xdata::Create();
+    xdata::Set(typed_sp.get(), -1, int64_t(1));
+    EXPECT_EQ(legacy_sp->Fingerprint(), typed_sp->Fingerprint());
+}
+
+TEST(xdata_tests, data_concrete)
+{
+    auto xdata_p = XData::Create();
+
+    EXPECT_EQ(xdata::Set(xdata_p.get(), -1, int64_t(1)), 0);
+    EXPECT_EQ(xdata::Set(xdata_p.get(), -1, int64_t(2)), 1);
+    EXPECT_EQ(xdata::Set(xdata_p.get(), -1, std::string("str"), 5), 0);
+    EXPECT_EQ(xdata::Set(xdata_p.get(), "pts"_key, -1, int64_t(3)), 0);
+
+    EXPECT_EQ(xdata::Count<int64_t>(xdata_p.get()), 2);
+    EXPECT_EQ(xdata::GetCopy<int64_t>(xdata_p.get(), 1), 2);
+    EXPECT_EQ(xdata::GetCopy<int64_t>(xdata_p.get(), "pts"_key), 3);
+    ASSERT_TRUE(xdata::Peek<std::string>(xdata_p.get()));
+    EXPECT_EQ(*xdata::Peek<std::string>(xdata_p.get()), "str");
+
+    std::any holder;
+    auto     str_sp = xdata::Get<std::string>(xdata_p.get(), 0, &holder);
+    ASSERT_TRUE(str_sp);
+    ASSERT_TRUE(xdata::AnyUnwrap<int>(holder));
+    EXPECT_EQ(*xdata::AnyUnwrap<int>(holder), 5);
+
+    // xdata::Create() creates XData
+    auto data_sp = xdata::Create();
+    EXPECT_TRUE(dynamic_cast<XData*>(data_sp.get()));
+    EXPECT_TRUE(dynamic_cast<XData*>(xdata_p->Clone().get()));
+}
+
+TEST(xdata_tests, data_clone_into)
+{
+    auto src_p = xdata::Create();
+    xdata::Set(src_p.get(), -1, int64_t(1));
+    xdata::Set(src_p.get(), -1, int64_t(2));
+    xdata::Set(src_p.get(), -1, std::string("str"));
+
+    auto dst_p = xdata::Create();
+    xdata::Set(dst_p.get(), -1, 1.5);
+    src_p->CloneInto(*dst_p, {xbase::TypeUid<std::string>()});
+    EXPECT_EQ(xdata::Count<double>(dst_p.get()), 0);
+    EXPECT_EQ(xdata::Count<std::string>(dst_p.get()), 0);
+    EXPECT_EQ(xdata::Count<int64_t>(dst_p.get()), 2);
+    EXPECT_EQ(xdata::GetCopy<int64_t>(dst_p.get(), 1), 2);
+    EXPECT_EQ(dst_p->Fingerprint(), src_p->Fingerprint({xbase::TypeUid<std::string>()}));
+
+    // Into other implementation
+    xdata::Record<int64_t> record;
+    xdata::Set(&record, -1, 1.5);
+    src_p->CloneInto(record);
+    EXPECT_EQ(record.Count<int64_t>(), 2);
+    EXPECT_EQ(xdata::Count<double>(&record), 0);
+    EXPECT_EQ(record.Fingerprint(), src_p->Fingerprint());
+
+    // Into itself
+    src_p->CloneInto(*src_p, {xbase::TypeUid<std::string>()}, IData::CloneSetType::Include);
+    EXPECT_EQ(xdata::Count<int64_t>(src_p.get()), 0);
+    EXPECT_EQ(xdata::GetCopy<std::string>(src_p.get()), "str");
+
+    // Clear removes all the data
+    auto usage = dst_p->DataMemoryUsage();
+    EXPECT_GT(usage, 0);
+    dst_p->Clear();
+    EXPECT_EQ(dst_p->DataMemoryUsage(), 0);
+    EXPECT_EQ(xdata::Count<int64_t>(dst_p.get()), 0);
+    EXPECT_EQ(dst_p->Fingerprint(), xdata::Create()->Fingerprint());
+    EXPECT_EQ(dst_p->Clone()->Fingerprint(), xdata::Create()->Fingerprint());
+
+    // Slots kept by Clear() are empty, so there is nothing to reset
+    EXPECT_FALSE(dst_p->DataReset(xbase::TypeUid<int64_t>()));
+    xdata::Set(&record, -1, 1.5);
+    record.Clear();
+    EXPECT_FALSE(record.DataReset(xbase::TypeUid<int64_t>()));
+    EXPECT_FALSE(record.DataReset(xbase::TypeUid<double>()));
+
+    // Slots unused since the previous Clear() are dropped by the next one
+    xdata::Set(&record, -1, 2.5);
+    record.Clear();
+    record.Clear();
+    EXPECT_EQ(xdata::Count<double>(&record), 0);
+    EXPECT_EQ(xdata::Set(&record, -1, 3.5), 0);
+    EXPECT_TRUE(record.DataReset(xbase::TypeUid<double>()));
+}
+
+TEST(xdata_tests, data_pool)
+{
+    xdata::Pool pool(2);
+    EXPECT_EQ(pool.FreeCount(), 0);
+
+    XData* recycled_p = nullptr;
+    {
+        auto xdata_p = pool.Acquire();
+        xdata::Set(xdata_p.get(), -1, int64_t(1));
+        xdata_p->DataBudgetSet(1);
+        recycled_p = xdata_p.get();
+    }
+    EXPECT_EQ(pool.FreeCount(), 1);
+
+    auto xdata_p = pool.Acquire();
+    EXPECT_EQ(xdata_p.get(), recycled_p);
+    EXPECT_EQ(pool.FreeCount(), 0);
+    EXPECT_EQ(xdata::Count<int64_t>(xdata_p.get()), 0);
+    EXPECT_EQ(xdata_p->DataMemoryUsage(), 0);
+
+    // Budget settings are reset on recycle
+    xdata::Set(xdata_p.get(), -1, int64_t(1));
+    xdata::Set(xdata_p.get(), -1, int64_t(2));
+    EXPECT_EQ(xdata::Count<int64_t>(xdata_p.get()), 2);
+
+    {
+        auto other_p  = pool.Acquire();
+        auto third_p  = pool.Acquire();
+        auto fourth_p = pool.Acquire();
+    }
+    EXPECT_EQ(pool.FreeCount(), 2);
+
+    // Container outliving the pool is deleted on release
+    auto outliving_p = std::make_unique<xdata::Pool>(2)->Acquire();
+    xdata::Set(outliving_p.get(), -1, int64_t(1));
+    EXPECT_TRUE(outliving_p.get_deleter().state_wp.expired());
+    outliving_p.reset();
+}
+
+TEST(xdata_tests, data_type_filter)
+{
+    auto filter = xdata::TypeFilter::Of<int64_t, std::string>(IData::CloneSetType::Include);
+    EXPECT_TRUE(filter.Match(xbase::TypeUid<int64_t>()));
+    EXPECT_TRUE(filter.Match(xbase::TypeUid<std::string>()));
+    EXPECT_FALSE(filter.Match(xbase::TypeUid<double>()));
+    EXPECT_FALSE(filter.All());
+    EXPECT_TRUE(xdata::TypeFilter().All());
+
+    // Compile time and runtime built filters are the same
+    xdata::TypeFilter set_filter({xbase::TypeUid<std::string>(), xbase::TypeUid<int64_t>()},
+                                 IData::CloneSetType::Include);
+    EXPECT_EQ(filter.Key(), set_filter.Key());
+    auto exclude_filter = xdata::TypeFilter::Of<int64_t, std::string>(IData::CloneSetType::Exclude);
+    EXPECT_NE(filter.Key(), exclude_filter.Key());
+    EXPECT_FALSE(exclude_filter.Match(xbase::TypeUid<int64_t>()));
+    EXPECT_TRUE(exclude_filter.Match(xbase::TypeUid<double>()));
+
+    auto data_sp = xdata::Create();
+    xdata::Set(data_sp.get(), -1, int64_t(1));
+    xdata::Set(data_sp.get(), -1, std::string("str"));
+    xdata::Set(data_sp.get(), -1, 1.5);
+
+    auto clone_sp = data_sp->Clone(filter);
+    EXPECT_EQ(xdata::Count<int64_t>(clone_sp.get()), 1);
+    EXPECT_EQ(xdata::Count<std::string>(clone_sp.get()), 1);
+    EXPECT_EQ(xdata::Count<double>(clone_sp.get()), 0);
+    EXPECT_EQ(clone_sp->Fingerprint(), data_sp->Fingerprint(filter));
+    EXPECT_EQ(data_sp->Fingerprint(filter),
+              data_sp->Fingerprint({xbase::TypeUid<int64_t>(), xbase::TypeUid<std::string>()},
+                                   IData::CloneSetType::Include));
+
+    auto excluded_sp = data_sp->Clone(xdata::TypeFilter::Of<double>(IData::CloneSetType::Exclude));
+    EXPECT_EQ(excluded_sp->Fingerprint(), clone_sp->Fingerprint());
+
+    // Large filter uses binary search
+    std::set<uint64_t> types;
+    for (uint64_t uid = 1; uid <= 100; ++uid)
+        types.insert(uid * 0x9e3779b97f4a7c15);
+    types.insert(xbase::TypeUid<double>());
+    xdata::TypeFilter large_filter(types, IData::CloneSetType::Include);
+    EXPECT_TRUE(large_filter.Match(xbase::TypeUid<double>()));
+    EXPECT_FALSE(large_filter.Match(xbase::TypeUid<int64_t>()));
+    EXPECT_EQ(xdata::Count<double>(data_sp->Clone(large_filter).get()), 1);
+}
+
+TEST(xdata_tests, data_freeze)
+{
+    auto data_sp = xdata::Create();
+    xdata::Set(data_sp.get(), -1, int64_t(1));
+    xdata::Set(data_sp.get(), -1, int64_t(2));
+    xdata::Set(data_sp.get(), -1, std::string("str"));
+    xdata::SetLazy<double>(data_sp.get(), -1, [] { return 1.5; });
+
+    auto frozen_sp = data_sp->Freeze();
+    ASSERT_TRUE(frozen_sp);
+    EXPECT_EQ(xdata::Count<int64_t>(frozen_sp.get()), 2);
+    EXPECT_EQ(xdata::GetCopy<int64_t>(frozen_sp.get(), 1), 2);
+    EXPECT_EQ(xdata::GetCopy<std::string>(frozen_sp.get()), "str");
+    EXPECT_EQ(xdata::GetCopy<double>(frozen_sp.get()), 1.5);
+    EXPECT_EQ(xdata::Count<float>(frozen_sp.get()), 0);
+    EXPECT_EQ(frozen_sp->Fingerprint(), data_sp->Fingerprint());
+    EXPECT_EQ(frozen_sp->DataMemoryUsage(), data_sp->DataMemoryUsage());
+    EXPECT_EQ(frozen_sp->Freeze(), frozen_sp);
+
+    // Values are shared, not copied
+    EXPECT_EQ(xdata::Peek<std::string>(frozen_sp.get()), xdata::Peek<std::string>(data_sp.get()));
+
+    // Source changes don't affect the snapshot
+    xdata::Set(data_sp.get(), 0, int64_t(10));
+    data_sp->DataReset(xbase::TypeUid<std::string>());
+    EXPECT_EQ(xdata::GetCopy<int64_t>(frozen_sp.get()), 1);
+    EXPECT_EQ(xdata::GetCopy<std::string>(frozen_sp.get()), "str");
+
+    // Mutations fail
+    auto* mutable_p = const_cast<IData*>(frozen_sp.get());
+    EXPECT_EQ(xdata::Set(mutable_p, -1, int64_t(3)), size_t(-1));
+    EXPECT_FALSE(mutable_p->DataReset(xbase::TypeUid<int64_t>()));
+    EXPECT_FALSE(mutable_p->DataRemoveEntry(xbase::TypeUid<int64_t>()).face.HasValue());
+    mutable_p->Clear();
+    EXPECT_EQ(xdata::Count<int64_t>(frozen_sp.get()), 2);
+
+    // Full fingerprint is computed once, filtered ones on every call
+    auto fingerprint = frozen_sp->Fingerprint();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([&] { EXPECT_EQ(frozen_sp->Fingerprint(), fingerprint); });
+    for (auto& thread : threads)
+        thread.join();
+    auto filter = xdata::TypeFilter::Of<int64_t>(IData::CloneSetType::Include);
+    EXPECT_EQ(frozen_sp->Fingerprint(filter), frozen_sp->Clone(filter)->Fingerprint());
+    EXPECT_NE(frozen_sp->Fingerprint(filter), fingerprint);
+
+    // Thaw into a mutable copy
+    auto thawed_p = frozen_sp->Clone(xdata::TypeFilter::Of<double>(IData::CloneSetType::Exclude));
+    EXPECT_TRUE(dynamic_cast<XData*>(thawed_p.get()));
+    EXPECT_EQ(xdata::Count<double>(thawed_p.get()), 0);
+    EXPECT_EQ(xdata::Set(thawed_p.get(), -1, int64_t(3)), 2);
+    EXPECT_EQ(xdata::Count<int64_t>(frozen_sp.get()), 2);
+
+    // Record and empty containers
+    xdata::Record<int64_t> record;
+    xdata::Set(&record, -1, int64_t(1));
+    xdata::Set(&record, -1, 1.5);
+    auto frozen_record_sp = record.Freeze();
+    EXPECT_EQ(frozen_record_sp->Fingerprint(), record.Fingerprint());
+    EXPECT_EQ(xdata::GetCopy<double>(frozen_record_sp.get()), 1.5);
+    EXPECT_EQ(xdata::Create()->Freeze()->Fingerprint(), xdata::Create()->Fingerprint());
+}
+
+TEST(xdata_tests, data_gather_scatter)
+{
+    // Large enough for the parallel execution, the threads count is forced as the machine may have a single core
+    constexpr size_t kFrames  = xdata::detail::kGatherGrain * 4 + 7;
+    constexpr size_t kThreads = 4;
+
+    std::vector<IData::UPtr> frames_holder;
+    std::vector<IData*>      frames;
+    for (size_t i = 0; i < kFrames; ++i) {
+        if (i % 3 == 0)
+            frames_holder.push_back(std::make_unique<xdata::Record<int64_t>>());
+        else
+            frames_holder.push_back(xdata::Create());
+        frames.push_back(i % 100 == 99 ? nullptr : frames_holder.back().get());
+    }
+
+    std::vector<int64_t> values(kFrames);
+    for (size_t i = 0; i < kFrames; ++i)
+        values[i] = int64_t(i) * 10;
+    EXPECT_EQ(xdata::Scatter(frames, values, 0, kThreads), kFrames - kFrames / 100);
+
+    std::vector<const IData*> const_frames(frames.begin(), frames.end());
+    std::vector<int64_t>      gathered;
+    EXPECT_EQ(xdata::Gather(const_frames, gathered, 0, kThreads), kFrames - kFrames / 100);
+    ASSERT_EQ(gathered.size(), kFrames);
+    for (size_t i = 0; i < kFrames; ++i)
+        EXPECT_EQ(gathered[i], i % 100 == 99 ? 0 : int64_t(i) * 10);
+
+    // Missed items are left unchanged
+    std::vector<double> missed(kFrames, -1.0);
+    EXPECT_EQ(xdata::Gather(const_frames.data(), const_frames.size(), missed.data(), 0, kThreads), 0);
+    EXPECT_EQ(missed.front(), -1.0);
+
+    // Small input, added as a second item
+    EXPECT_EQ(xdata::Scatter(frames.data(), 2, values.data() + 5, -1), 2);
+    EXPECT_EQ(xdata::Gather(const_frames.data(), 2, gathered.data(), 1), 2);
+    EXPECT_EQ(gathered[0], 50);
+    EXPECT_EQ(gathered[1], 60);
+
+    // Every index is processed once, the workers are reused and exceptions are passed to the caller
+    for (int pass = 0; pass < 3; ++pass) {
+        std::vector<std::atomic<int>> calls(1000);
+        xdata::detail::ParallelFor(
+            calls.size(),
+            1,
+            [&](size_t _begin, size_t _end) {
+                for (size_t i = _begin; i < _end; ++i)
+                    ++calls[i];
+            },
+            kThreads);
+        EXPECT_TRUE(std::all_of(calls.begin(), calls.end(), [](const auto& _calls) { return _calls == 1; }));
+    }
+    auto throw_chunk = [](size_t _begin, size_t) {
+        if (_begin)
+            throw std::runtime_error("chunk");
+    };
+    EXPECT_THROW(xdata::detail::ParallelFor(100, 1, throw_chunk, kThreads), std::runtime_error);
+}
+
 // TEST(xdata_tests, data_set_holder)
 //{
 //     auto data_sp = std::make_shared<XDataImpl>();
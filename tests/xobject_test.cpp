@@ -2,6 +2,9 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+#include <vector>
+
 using namespace xsdk;
 
 // NOLINTBEGIN(*)
@@ -144,4 +147,88 @@ TEST(xobject_test, ptr_query_const)
     EXPECT_EQ("some name", obj_sp2->NameGet());
 }
 
+TEST(xobject_test, registry_find)
+{
+    auto io_test = IObjectTest::Create("registered");
+    auto uid     = io_test->ObjectUid();
+    EXPECT_FALSE(xobject::Find(uid));
+
+    auto registration = xobject::Register(io_test);
+    EXPECT_EQ(registration.ObjectUid(), uid);
+    EXPECT_EQ(xobject::Find(uid), io_test);
+
+    auto found_sp = xobject::Find<IObjectTest>(uid);
+    ASSERT_TRUE(found_sp);
+    EXPECT_EQ("registered", found_sp->NameGet());
+
+    // Destroyed object is not found even while registered
+    found_sp.reset();
+    io_test.reset();
+    EXPECT_FALSE(xobject::Find(uid));
+}
+
+TEST(xobject_test, registry_deregistration)
+{
+    auto io_test = IObjectTest::Create();
+    auto uid     = io_test->ObjectUid();
+    {
+        auto registration = xobject::Register(io_test);
+        EXPECT_TRUE(xobject::Find(uid));
+
+        auto moved = std::move(registration);
+        EXPECT_EQ(registration.ObjectUid(), 0);
+        EXPECT_TRUE(xobject::Find(uid));
+    }
+    EXPECT_FALSE(xobject::Find(uid));
+
+    // Stale registration does not remove the newer one
+    auto first  = xobject::Register(io_test);
+    auto second = xobject::Register(io_test);
+    first.Reset();
+    EXPECT_EQ(xobject::Find(uid), io_test);
+    second.Reset();
+    EXPECT_FALSE(xobject::Find(uid));
+
+    EXPECT_EQ(xobject::Register(nullptr).ObjectUid(), 0);
+}
+
+TEST(xobject_test, registry_snapshot)
+{
+    std::vector<std::shared_ptr<IObjectTest>> objects;
+    std::vector<xobject::Registration>        registrations;
+    for (int i = 0; i < 100; ++i) {
+        objects.push_back(IObjectTest::Create());
+        registrations.push_back(xobject::Register(objects.back()));
+    }
+    objects.resize(50);
+
+    size_t found = 0;
+    for (const auto& obj_sp : xobject::Snapshot()) {
+        for (const auto& object : objects)
+            found += obj_sp == object;
+    }
+    EXPECT_EQ(found, objects.size());
+}
+
+TEST(xobject_test, registry_concurrent)
+{
+    constexpr int kThreads = 8;
+    constexpr int kObjects = 2000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < kObjects; ++i) {
+                auto io_test      = IObjectTest::Create();
+                auto registration = xobject::Register(io_test);
+                EXPECT_EQ(xobject::Find(io_test->ObjectUid()), io_test);
+                if (i % 500 == 0)
+                    xobject::Snapshot();
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+}
+
 // NOLINTEND(*)
\ No newline at end of file